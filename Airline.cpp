@@ -3,6 +3,9 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
 #include <iomanip>
 #include <ctime>
 #include <algorithm>
@@ -10,18 +13,51 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <memory>
+#include <functional>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <string_view>
+#include <charconv>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <utility>
+#include <random>
+#include <chrono>
+#include <filesystem>
+#include <cerrno>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 #ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
 #include <direct.h>
 #include <io.h>
+#include <fcntl.h>
 #define MKDIR(dir) _mkdir(dir)
 #define FILE_EXISTS(file) (_access(file, 0) != -1)
+#define REPLACE_FILE(from, to) (remove(to), rename(from, to) == 0)
 #else
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <poll.h>
+#include <csignal>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 #define MKDIR(dir) mkdir(dir, 0755)
 #define FILE_EXISTS(file) (access(file, F_OK) != -1)
+#define REPLACE_FILE(from, to) (rename(from, to) == 0)
 #endif
 
 using namespace std;
@@ -34,9 +70,29 @@ string toLower(string s) {
 }
 
 bool equalsIgnoreCase(const string& a, const string& b) {
-    return toLower(a) == toLower(b);
+    return a.size() == b.size() &&
+           equal(a.begin(), a.end(), b.begin(), [](unsigned char x, unsigned char y) {
+               return tolower(x) == tolower(y);
+           });
 }
 
+struct CaseInsensitiveHash {
+    size_t operator()(const string& s) const {
+        size_t hash = 14695981039346656037ULL;
+        for (unsigned char c : s) {
+            hash ^= static_cast<size_t>(tolower(c));
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+};
+
+struct CaseInsensitiveEqual {
+    bool operator()(const string& a, const string& b) const {
+        return equalsIgnoreCase(a, b);
+    }
+};
+
 bool containsIgnoreCase(const string& haystack, const string& needle) {
     return toLower(haystack).find(toLower(needle)) != string::npos;
 }
@@ -61,6 +117,314 @@ bool isAlphaNumeric(const string& str) {
     });
 }
 
+#define METRIC_CONCAT_INNER(a, b) a##b
+#define METRIC_CONCAT(a, b) METRIC_CONCAT_INNER(a, b)
+
+#ifdef AIRLINE_DISABLE_METRICS
+#define METRIC_SPAN(name)
+#define METRIC_COUNT(name)
+#else
+#define METRIC_SPAN(name) \
+    static Metrics::Histogram& METRIC_CONCAT(metricHistogram, __LINE__) = Metrics::histogram(name); \
+    Metrics::Span METRIC_CONCAT(metricSpan, __LINE__)(METRIC_CONCAT(metricHistogram, __LINE__), name)
+#define METRIC_COUNT(name) \
+    do { \
+        if (Metrics::enabled()) { \
+            static Metrics::Counter& metricCounter = Metrics::counter(name); \
+            metricCounter.add(); \
+        } \
+    } while (0)
+#endif
+
+class Metrics {
+public:
+    class Counter {
+    private:
+        atomic<uint64_t> value;
+
+    public:
+        Counter() : value(0) {}
+
+        void add(uint64_t amount = 1) { value.fetch_add(amount, memory_order_relaxed); }
+        uint64_t get() const { return value.load(memory_order_relaxed); }
+        void reset() { value.store(0, memory_order_relaxed); }
+    };
+
+    class Histogram {
+    public:
+        static constexpr size_t bucketCount = 20;
+        static constexpr array<uint64_t, bucketCount> bounds = {
+            1000, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000, 2500000,
+            5000000, 10000000, 25000000, 50000000, 100000000, 250000000, 500000000,
+            1000000000, 2500000000, 10000000000
+        };
+
+    private:
+        array<atomic<uint64_t>, bucketCount + 1> buckets;
+        atomic<uint64_t> count;
+        atomic<uint64_t> totalNanoseconds;
+
+    public:
+        Histogram() : count(0), totalNanoseconds(0) {
+            for (auto& bucket : buckets) {
+                bucket.store(0, memory_order_relaxed);
+            }
+        }
+
+        void observe(uint64_t nanoseconds) {
+            size_t index = lower_bound(bounds.begin(), bounds.end(), nanoseconds) - bounds.begin();
+            buckets[index].fetch_add(1, memory_order_relaxed);
+            count.fetch_add(1, memory_order_relaxed);
+            totalNanoseconds.fetch_add(nanoseconds, memory_order_relaxed);
+        }
+
+        uint64_t bucket(size_t index) const { return buckets[index].load(memory_order_relaxed); }
+        uint64_t getCount() const { return count.load(memory_order_relaxed); }
+        uint64_t getTotalNanoseconds() const { return totalNanoseconds.load(memory_order_relaxed); }
+
+        uint64_t quantile(double fraction) const {
+            uint64_t total = getCount();
+            if (total == 0) {
+                return 0;
+            }
+            
+            uint64_t target = max<uint64_t>(1, static_cast<uint64_t>(fraction * total + 0.5));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < bucketCount; i++) {
+                seen += bucket(i);
+                if (seen >= target) {
+                    return bounds[i];
+                }
+            }
+            return bounds[bucketCount - 1];
+        }
+
+        void reset() {
+            for (auto& bucket : buckets) {
+                bucket.store(0, memory_order_relaxed);
+            }
+            count.store(0, memory_order_relaxed);
+            totalNanoseconds.store(0, memory_order_relaxed);
+        }
+    };
+
+    struct TraceEvent {
+        const char* name;
+        uint64_t thread;
+        uint64_t startMicroseconds;
+        uint64_t durationNanoseconds;
+        int depth;
+    };
+
+    class Span {
+    private:
+        static thread_local int depth;
+
+        Histogram* histogram;
+        const char* name;
+        chrono::steady_clock::time_point start;
+
+    public:
+        Span(Histogram& target, const char* name) : histogram(nullptr), name(name) {
+            if (!Metrics::enabled()) {
+                return;
+            }
+            histogram = &target;
+            depth++;
+            start = chrono::steady_clock::now();
+        }
+
+        ~Span() {
+            if (histogram == nullptr) {
+                return;
+            }
+            
+            auto finished = chrono::steady_clock::now();
+            uint64_t elapsed = chrono::duration_cast<chrono::nanoseconds>(finished - start).count();
+            histogram->observe(elapsed);
+            depth--;
+            
+            if (Metrics::tracing()) {
+                Metrics::recordTrace({name, hash<thread::id>()(this_thread::get_id()),
+                                      static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(
+                                          start - Metrics::started).count()),
+                                      elapsed, depth});
+            }
+        }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+    };
+
+private:
+    static constexpr size_t traceCapacity = 512;
+
+    static const chrono::steady_clock::time_point started;
+    static atomic<bool> enabledFlag;
+    static atomic<bool> tracingFlag;
+    static mutex registryMutex;
+    static map<string, unique_ptr<Histogram>> histograms;
+    static map<string, unique_ptr<Counter>> counters;
+    static mutex traceMutex;
+    static vector<TraceEvent> traceRing;
+    static size_t traceNext;
+    static int dumpInterval;
+    static string dumpFile;
+    static chrono::steady_clock::time_point nextDump;
+
+    static string formatSeconds(double seconds) {
+        ostringstream out;
+        out << seconds;
+        return out.str();
+    }
+
+public:
+    static bool enabled() {
+#ifdef AIRLINE_DISABLE_METRICS
+        return false;
+#else
+        return enabledFlag.load(memory_order_relaxed);
+#endif
+    }
+
+    static bool tracing() { return tracingFlag.load(memory_order_relaxed); }
+
+    static void setEnabled(bool enable) {
+#ifndef AIRLINE_DISABLE_METRICS
+        enabledFlag.store(enable, memory_order_relaxed);
+#endif
+    }
+
+    static void setTracing(bool enable) {
+        if (enable) {
+            setEnabled(true);
+        }
+        tracingFlag.store(enable && enabled(), memory_order_relaxed);
+    }
+
+    static Histogram& histogram(const string& name) {
+        lock_guard<mutex> guard(registryMutex);
+        unique_ptr<Histogram>& entry = histograms[name];
+        if (!entry) {
+            entry = make_unique<Histogram>();
+        }
+        return *entry;
+    }
+
+    static Counter& counter(const string& name) {
+        lock_guard<mutex> guard(registryMutex);
+        unique_ptr<Counter>& entry = counters[name];
+        if (!entry) {
+            entry = make_unique<Counter>();
+        }
+        return *entry;
+    }
+
+    static void recordTrace(const TraceEvent& event) {
+        lock_guard<mutex> guard(traceMutex);
+        if (traceRing.size() < traceCapacity) {
+            traceRing.push_back(event);
+        } else {
+            traceRing[traceNext] = event;
+        }
+        traceNext = (traceNext + 1) % traceCapacity;
+    }
+
+    static vector<TraceEvent> recentTraces(size_t limit) {
+        lock_guard<mutex> guard(traceMutex);
+        vector<TraceEvent> events;
+        size_t available = min(limit, traceRing.size());
+        for (size_t i = 0; i < available; i++) {
+            size_t slot = (traceNext + traceCapacity - available + i) % traceCapacity;
+            events.push_back(traceRing[slot]);
+        }
+        return events;
+    }
+
+    static void reset() {
+        {
+            lock_guard<mutex> guard(registryMutex);
+            for (auto& entry : histograms) {
+                entry.second->reset();
+            }
+            for (auto& entry : counters) {
+                entry.second->reset();
+            }
+        }
+        
+        lock_guard<mutex> guard(traceMutex);
+        traceRing.clear();
+        traceNext = 0;
+    }
+
+    static string renderPrometheus() {
+        lock_guard<mutex> guard(registryMutex);
+        string text;
+        
+        for (const auto& entry : counters) {
+            string name = "airline_" + entry.first + "_total";
+            text += "# TYPE " + name + " counter\n";
+            text += name + " " + to_string(entry.second->get()) + "\n";
+        }
+        
+        for (const auto& entry : histograms) {
+            const Histogram& histogram = *entry.second;
+            string name = "airline_" + entry.first + "_seconds";
+            text += "# TYPE " + name + " histogram\n";
+            
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < Histogram::bucketCount; i++) {
+                cumulative += histogram.bucket(i);
+                text += name + "_bucket{le=\"" + formatSeconds(Histogram::bounds[i] / 1e9) + "\"} " +
+                        to_string(cumulative) + "\n";
+            }
+            text += name + "_bucket{le=\"+Inf\"} " + to_string(histogram.getCount()) + "\n";
+            text += name + "_sum " + formatSeconds(histogram.getTotalNanoseconds() / 1e9) + "\n";
+            text += name + "_count " + to_string(histogram.getCount()) + "\n";
+        }
+        return text;
+    }
+
+    static vector<string> summaryFields() {
+        lock_guard<mutex> guard(registryMutex);
+        vector<string> fields = {enabled() ? "on" : "off", to_string(histograms.size())};
+        
+        for (const auto& entry : histograms) {
+            const Histogram& histogram = *entry.second;
+            fields.push_back(entry.first);
+            fields.push_back(to_string(histogram.getCount()));
+            fields.push_back(to_string(histogram.getTotalNanoseconds() / 1000));
+            fields.push_back(to_string(histogram.quantile(0.5) / 1000));
+            fields.push_back(to_string(histogram.quantile(0.99) / 1000));
+        }
+        
+        fields.push_back(to_string(counters.size()));
+        for (const auto& entry : counters) {
+            fields.push_back(entry.first);
+            fields.push_back(to_string(entry.second->get()));
+        }
+        return fields;
+    }
+
+    static void configure();
+    static bool dump();
+    static void dumpIfDue();
+};
+
+thread_local int Metrics::Span::depth = 0;
+const chrono::steady_clock::time_point Metrics::started = chrono::steady_clock::now();
+atomic<bool> Metrics::enabledFlag(true);
+atomic<bool> Metrics::tracingFlag(false);
+mutex Metrics::registryMutex;
+map<string, unique_ptr<Metrics::Histogram>> Metrics::histograms;
+map<string, unique_ptr<Metrics::Counter>> Metrics::counters;
+mutex Metrics::traceMutex;
+vector<Metrics::TraceEvent> Metrics::traceRing;
+size_t Metrics::traceNext = 0;
+int Metrics::dumpInterval = 0;
+string Metrics::dumpFile = "metrics.prom";
+chrono::steady_clock::time_point Metrics::nextDump;
+
 void printHeader(const string& title) {
     cout << "\n" << string(80, '-') << "\n";
     cout << "  " << title << "\n";
@@ -73,51 +437,60 @@ void printSubHeader(const string& title) {
 }
 
 void printMenuOption(int number, const string& option) {
-    cout << "  [" << number << "] " << option << endl;
+    cout << "  [" << number << "] " << option << "\n";
 }
 
 void printBackOption() {
-    cout << "  [0] Back to previous menu" << endl;
+    cout << "  [0] Back to previous menu\n";
 }
 
 void printSuccessMessage(const string& message) {
-    cout << "\n  ✓ " << message << endl;
+    cout << "\n  ✓ " << message << "\n";
 }
 
 void printErrorMessage(const string& message) {
-    cout << "\n  ! " << message << endl;
+    METRIC_COUNT("errors");
+    cout << "\n  ! " << message << "\n";
 }
 
 void printInfoMessage(const string& message) {
-    cout << "\n  ! " << message << endl;
+    cout << "\n  ! " << message << "\n";
 }
 
 void printWarningMessage(const string& message) {
-    cout << "\n  * " << message << endl;
+    cout << "\n  * " << message << "\n";
 }
 
-void printTableHeader(const vector<pair<string, int>>& columns) {
-    for (const auto& col : columns) {
-        cout << setw(col.second) << left << col.first;
+void appendCells(string& line, const vector<pair<string, int>>& cells) {
+    for (const auto& cell : cells) {
+        line += cell.first;
+        if (cell.first.size() < static_cast<size_t>(cell.second)) {
+            line.append(cell.second - cell.first.size(), ' ');
+        }
     }
-    cout << endl;
+    line += '\n';
+}
 
-    string separator;
+void printTableHeader(const vector<pair<string, int>>& columns) {
+    string lines;
+    appendCells(lines, columns);
+    
     for (const auto& col : columns) {
-        separator += string(col.second, '-');
+        lines.append(col.second, '-');
     }
-    cout << separator << endl;
+    lines += '\n';
+    
+    cout.write(lines.data(), lines.size());
 }
 
 void printTableRow(const vector<pair<string, int>>& values) {
-    for (const auto& val : values) {
-        cout << setw(val.second) << left << val.first;
-    }
-    cout << endl;
+    string line;
+    appendCells(line, values);
+    cout.write(line.data(), line.size());
 }
 
 void printSeparator() {
-    cout << string(80, '-') << endl;
+    cout << string(80, '-') << "\n";
 }
 
 void printPrompt(const string& prompt) {
@@ -228,24 +601,25 @@ public:
     }
 };
 
+class CsvRecord;
+
 class DatabaseManager {
 private:
     DatabaseManager() {}
 
-    static DatabaseManager* instance;
+    map<string, string> batches;
 
     DatabaseManager(const DatabaseManager&) = delete;
     DatabaseManager& operator=(const DatabaseManager&) = delete;
 
 public:
     static DatabaseManager* getInstance() {
-        if (instance == nullptr) {
-            instance = new DatabaseManager();
-        }
-        return instance;
+        static DatabaseManager manager;
+        return &manager;
     }
 
     bool saveData(const string& filename, const string& data) {
+        METRIC_SPAN("db_append");
         try {
             if (data.empty()) {
                 return deleteFile(filename);
@@ -255,7 +629,7 @@ public:
             if (!file.is_open()) {
                 throw FileOperationException("Failed to open file: " + filename);
             }
-            file << data << endl;
+            file << data << "\n";
             file.close();
             return true;
         } catch (const exception& e) {
@@ -265,17 +639,62 @@ public:
     }
 
     bool saveDataOverwrite(const string& filename, const string& data) {
+        if (data.empty()) {
+            return deleteFile(filename);
+        }
+        
+        return writeAtomically(filename, data);
+    }
+
+    static bool syncFile(const string& filename) {
+#ifdef _WIN32
+        int fd = _open(filename.c_str(), _O_RDWR | _O_BINARY);
+        if (fd < 0) {
+            return false;
+        }
+        bool synced = _commit(fd) == 0;
+        _close(fd);
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        bool synced = fsync(fd) == 0;
+        close(fd);
+#endif
+        return synced;
+    }
+
+    static void syncDirectoryOf(const string& filename) {
+#ifndef _WIN32
+        size_t slash = filename.find_last_of('/');
+        string directory = slash == string::npos ? "." : filename.substr(0, max<size_t>(slash, 1));
+        syncFile(directory);
+#endif
+    }
+
+    bool writeAtomically(const string& filename, const string& data, bool binary = false) {
+        METRIC_SPAN("db_write");
         try {
-            if (data.empty()) {
-                return deleteFile(filename);
-            }
+            string tempFilename = filename + ".tmp";
             
-            ofstream file(filename, ios::trunc);
+            ofstream file(tempFilename, binary ? ios::trunc | ios::binary : ios::trunc);
             if (!file.is_open()) {
-                throw FileOperationException("Failed to open file: " + filename);
+                throw FileOperationException("Failed to open file: " + tempFilename);
             }
-            file << data;
+            file.write(data.data(), data.size());
             file.close();
+            
+            if (file.fail() || !syncFile(tempFilename)) {
+                remove(tempFilename.c_str());
+                throw FileOperationException("Failed to write file: " + tempFilename);
+            }
+            
+            if (!REPLACE_FILE(tempFilename.c_str(), filename.c_str())) {
+                remove(tempFilename.c_str());
+                throw FileOperationException("Failed to replace file: " + filename);
+            }
+            syncDirectoryOf(filename);
             return true;
         } catch (const exception& e) {
             printErrorMessage("Error saving data: " + string(e.what()));
@@ -283,7 +702,31 @@ public:
         }
     }
 
+    void beginBatch(const string& filename) {
+        batches[filename].clear();
+    }
+
+    void appendToBatch(const string& filename, const string& record) {
+        string& buffer = batches[filename];
+        buffer += record;
+        buffer += '\n';
+    }
+
+    bool commitBatch(const string& filename) {
+        auto it = batches.find(filename);
+        if (it == batches.end()) {
+            return false;
+        }
+        
+        string data;
+        data.swap(it->second);
+        batches.erase(it);
+        
+        return writeAtomically(filename, data);
+    }
+
     string loadData(const string& filename) {
+        METRIC_SPAN("db_load");
         try {
             ifstream file(filename);
             if (!file.is_open()) {
@@ -301,17 +744,19 @@ public:
         }
     }
 
+    bool forEachRecord(const string& filename, const function<void(const CsvRecord&)>& visit);
+
+    bool forEachRecordParallel(const string& filename, size_t chunkCount,
+                               const function<void(size_t, const CsvRecord&)>& visit,
+                               const function<void(size_t, size_t)>& prepare = nullptr);
+
     bool fileExists(const string& filename) {
         return FILE_EXISTS(filename.c_str());
     }
 
     bool deleteFile(const string& filename) {
         try {
-            if (!fileExists(filename)) {
-                return true;
-            }
-            
-            if (remove(filename.c_str()) != 0) {
+            if (remove(filename.c_str()) != 0 && errno != ENOENT) {
                 throw FileOperationException("Failed to delete file: " + filename);
             }
             return true;
@@ -324,7 +769,97 @@ public:
     ~DatabaseManager() {}
 };
 
-DatabaseManager* DatabaseManager::instance = nullptr;
+class MappedFile {
+private:
+    const unsigned char* bytes;
+    size_t length;
+#ifdef _WIN32
+    vector<unsigned char> buffer;
+#else
+    void* mapping;
+#endif
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+#ifdef _WIN32
+    MappedFile() : bytes(nullptr), length(0) {}
+#else
+    MappedFile() : bytes(nullptr), length(0), mapping(nullptr) {}
+#endif
+
+    bool open(const string& filename) {
+        close();
+        
+#ifdef _WIN32
+        ifstream file(filename, ios::binary | ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        
+        streamsize size = file.tellg();
+        if (size <= 0) {
+            return false;
+        }
+        
+        buffer.resize(static_cast<size_t>(size));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(buffer.data()), size)) {
+            buffer.clear();
+            return false;
+        }
+        
+        bytes = buffer.data();
+        length = buffer.size();
+        return true;
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        
+        void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        
+        if (address == MAP_FAILED) {
+            return false;
+        }
+        
+        mapping = address;
+        bytes = static_cast<const unsigned char*>(address);
+        length = static_cast<size_t>(info.st_size);
+        return true;
+#endif
+    }
+
+    void close() {
+#ifdef _WIN32
+        buffer.clear();
+#else
+        if (mapping != nullptr) {
+            munmap(mapping, length);
+            mapping = nullptr;
+        }
+#endif
+        bytes = nullptr;
+        length = 0;
+    }
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+    bool isOpen() const { return bytes != nullptr; }
+
+    ~MappedFile() {
+        close();
+    }
+};
 
 class PaymentStrategy {
 public:
@@ -375,17 +910,134 @@ public:
 };
 
 vector<class Flight> flights;
-vector<class User*> users;
 vector<class Reservation> reservations;
 map<string, class WaitingList> waitingLists;
 class User* currentUser = nullptr;
 
-void clearScreen() {
+class ScreenBuffer : public streambuf {
+private:
+    static constexpr size_t capacity = 64 * 1024;
+
+    unique_ptr<char[]> storage;
+
+    static bool writeOut(const char* data, size_t length) {
+        while (length > 0) {
+#ifdef _WIN32
+            int written = _write(1, data, static_cast<unsigned int>(min<size_t>(length, 1 << 30)));
+#else
+            ssize_t written = ::write(STDOUT_FILENO, data, length);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+#endif
+            if (written <= 0) {
+                return false;
+            }
+            data += written;
+            length -= written;
+        }
+        return true;
+    }
+
+    bool emit() {
+        bool ok = writeOut(pbase(), pptr() - pbase());
+        setp(storage.get(), storage.get() + capacity);
+        return ok;
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!emit()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    streamsize xsputn(const char* data, streamsize count) override {
+        if (static_cast<size_t>(count) > static_cast<size_t>(epptr() - pptr())) {
+            if (!emit()) {
+                return 0;
+            }
+            if (static_cast<size_t>(count) >= capacity) {
+                return writeOut(data, count) ? count : 0;
+            }
+        }
+        memcpy(pptr(), data, count);
+        pbump(static_cast<int>(count));
+        return count;
+    }
+
+    int sync() override {
+        return emit() ? 0 : -1;
+    }
+
+public:
+    ScreenBuffer() : storage(new char[capacity]) {
+        setp(storage.get(), storage.get() + capacity);
+    }
+};
+
+class Renderer {
+private:
+    static streambuf* original;
+    static bool headless;
+
+    static bool detectHeadless() {
+        const char* forced = getenv("AIRLINE_HEADLESS");
+        if (forced != nullptr && *forced != '\0') {
+            return strcmp(forced, "0") != 0;
+        }
 #ifdef _WIN32
-    system("cls");
+        return !_isatty(_fileno(stdout));
 #else
-    system("clear");
+        return !isatty(STDOUT_FILENO);
+#endif
+    }
+
+public:
+    static void install() {
+        headless = detectHeadless();
+        if (headless || original != nullptr) {
+            return;
+        }
+        
+#ifdef _WIN32
+        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        if (GetConsoleMode(console, &mode)) {
+            SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+        }
 #endif
+        static ScreenBuffer* screen = new ScreenBuffer();
+        cout.flush();
+        original = cout.rdbuf(screen);
+    }
+
+    static void uninstall() {
+        if (original == nullptr) {
+            return;
+        }
+        
+        cout.flush();
+        cout.rdbuf(original);
+        original = nullptr;
+    }
+
+    static bool isHeadless() { return headless; }
+};
+
+streambuf* Renderer::original = nullptr;
+bool Renderer::headless = true;
+
+void clearScreen() {
+    if (Renderer::isHeadless()) {
+        return;
+    }
+    cout << "\033[2J\033[H";
 }
 
 void pressEnterToContinue() {
@@ -404,835 +1056,4100 @@ bool createDirectory(const string& path) {
     return (result == 0 || errno == EEXIST);
 }
 
-string getCurrentDateTime() {
-    time_t now = time(0);
-    tm* ltm = localtime(&now);
-
-    string months[] = {"January", "February", "March", "April", "May", "June", 
-                      "July", "August", "September", "October", "November", "December"};
-
-    stringstream ss;
-    ss << months[ltm->tm_mon] << " " << ltm->tm_mday << ", " 
-       << 1900 + ltm->tm_year << " – ";
-
-    int hour = ltm->tm_hour;
-    string ampm = "AM";
-    if (hour >= 12) {
-        ampm = "PM";
-        if (hour > 12) hour -= 12;
-    }
-    if (hour == 0) hour = 12;
-
-    ss << setfill('0') << setw(2) << hour << ":" 
-       << setfill('0') << setw(2) << ltm->tm_min << " " << ampm;
+int64_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
 
-    return ss.str();
+void civilFromDays(int64_t days, int& year, int& month, int& day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+    day = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+    year = static_cast<int>(yearOfEra + era * 400 + (month <= 2));
 }
 
-string generateID(const string& prefix) {
-    static map<string, int> counters;
+constexpr int64_t unknownScheduleTime = INT64_MIN;
 
-    if (counters.find(prefix) == counters.end()) {
-        counters[prefix] = 10000;
-        
-        DatabaseManager* dbManager = DatabaseManager::getInstance();
-        string data;
-        int highestID = 10000;
-        
-        if (prefix == "FL") {
-            data = dbManager->loadData("flights.txt");
-        } else if (prefix == "RES") {
-            data = dbManager->loadData("reservations.txt");
-        } else if (prefix == "USR") {
-            data = dbManager->loadData("users.txt");
+bool parseScheduleTime(string_view text, int64_t& epochSeconds) {
+    static const char* const monthNames[] = {"january", "february", "march", "april", "may", "june",
+                                             "july", "august", "september", "october", "november", "december"};
+    
+    size_t position = 0;
+    auto skipSpaces = [&]() {
+        while (position < text.size() && text[position] == ' ') {
+            position++;
         }
-        
-        stringstream dataStream(data);
-        string line;
-        
-        while (getline(dataStream, line)) {
-            stringstream ss(line);
-            string token;
-            
-            if (getline(ss, token, ',')) {
-                if (token.substr(0, prefix.length()) == prefix) {
-                    string numPart = token.substr(prefix.length());
-                    try {
-                        int idNum = stoi(numPart);
-                        if (idNum > highestID) {
-                            highestID = idNum;
-                        }
-                    } catch (const exception& e) {
-                        continue;
-                    }
-                }
-            }
+    };
+    auto readNumber = [&](int& value) {
+        auto result = from_chars(text.data() + position, text.data() + text.size(), value);
+        if (result.ec != errc() || result.ptr == text.data() + position) {
+            return false;
         }
-        
-        counters[prefix] = highestID;
+        position = result.ptr - text.data();
+        return true;
+    };
+    
+    skipSpaces();
+    size_t wordStart = position;
+    while (position < text.size() && isalpha(static_cast<unsigned char>(text[position]))) {
+        position++;
+    }
+    string_view word = text.substr(wordStart, position - wordStart);
+    
+    int month = 0;
+    for (int i = 0; i < 12 && month == 0; i++) {
+        string_view name(monthNames[i]);
+        if (word.size() >= 3 && word.size() <= name.size() &&
+            equal(word.begin(), word.end(), name.begin(),
+                  [](char a, char b) { return tolower(static_cast<unsigned char>(a)) == b; })) {
+            month = i + 1;
+        }
+    }
+    
+    int day = 0;
+    int year = 0;
+    skipSpaces();
+    if (month == 0 || !readNumber(day) || position >= text.size() || text[position++] != ',') {
+        return false;
+    }
+    
+    skipSpaces();
+    if (!readNumber(year)) {
+        return false;
+    }
+    
+    skipSpaces();
+    if (text.substr(position, 3) == "\xE2\x80\x93") {
+        position += 3;
+    } else if (position < text.size() && text[position] == '-') {
+        position++;
+    } else {
+        return false;
+    }
+    
+    int hour = 0;
+    int minute = 0;
+    skipSpaces();
+    if (!readNumber(hour) || position >= text.size() || text[position++] != ':' || !readNumber(minute)) {
+        return false;
+    }
+    
+    skipSpaces();
+    string_view suffix = text.substr(position);
+    while (!suffix.empty() && suffix.back() == ' ') {
+        suffix.remove_suffix(1);
+    }
+    
+    if (suffix.size() == 2 && toupper(static_cast<unsigned char>(suffix[1])) == 'M') {
+        char meridiem = toupper(static_cast<unsigned char>(suffix[0]));
+        if ((meridiem != 'A' && meridiem != 'P') || hour < 1 || hour > 12) {
+            return false;
+        }
+        hour = hour % 12 + (meridiem == 'P' ? 12 : 0);
+    } else if (!suffix.empty()) {
+        return false;
     }
-
-    return prefix + to_string(++counters[prefix]);
-}
-
-vector<string> splitString(const string& str, char delimiter) {
-    vector<string> tokens;
-    stringstream ss(str);
-    string token;
     
-    while (getline(ss, token, delimiter)) {
-        tokens.push_back(token);
+    static const int daysInMonth[] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (day < 1 || day > daysInMonth[month - 1] || (month == 2 && day == 29 && !leapYear) ||
+        hour < 0 || hour > 23 || minute < 0 || minute > 59) {
+        return false;
     }
     
-    return tokens;
+    epochSeconds = ((daysFromCivil(year, month, day) * 24 + hour) * 60 + minute) * 60;
+    return true;
 }
 
-class Flight {
+class SegmentStore {
 private:
-    string flightID;
-    string airlineName;
-    string planeID;
-    int capacity;
-    int availableSeats;
-    string destination;
-    string departureTime;
-    string arrivalTime;
-    string status;
-    vector<vector<bool>> seatMap;
-    int seatsPerRow;
-    int totalColumns;
+    static constexpr uint32_t recordMagic = 0x31474553;
+    static constexpr uint32_t tombstone = UINT32_MAX;
+    static constexpr size_t headerSize = 16;
+    static constexpr uint64_t segmentLimit = 8 * 1024 * 1024;
+
+    struct Location {
+        uint32_t segment;
+        uint64_t offset;
+        uint32_t length;
+    };
+
+    string directory;
+    mutex storeMutex;
+    unordered_map<string, Location> index;
+    map<uint32_t, uint64_t> segments;
+    map<uint32_t, unique_ptr<ifstream>> readers;
+    ofstream writer;
+    uint32_t activeSegment;
+    uint64_t liveBytes;
+    uint64_t totalBytes;
+    bool unflushed;
+    bool opened;
+
+    SegmentStore(const SegmentStore&) = delete;
+    SegmentStore& operator=(const SegmentStore&) = delete;
+
+    string segmentPath(uint32_t segment) const {
+        char name[32];
+        snprintf(name, sizeof(name), "segment-%06u.dat", segment);
+        return directory + "/" + name;
+    }
 
-public:
-    Flight() : seatsPerRow(3), totalColumns(7) {}
+    static uint32_t checksum(string_view key, string_view payload) {
+        uint32_t hash = 2166136261u;
+        for (string_view part : {key, payload}) {
+            for (unsigned char c : part) {
+                hash ^= c;
+                hash *= 16777619u;
+            }
+        }
+        return hash;
+    }
 
-    Flight(const string& airlineName, const string& planeID, int capacity, 
-           const string& destination, const string& departureTime, 
-           const string& arrivalTime) 
-        : airlineName(airlineName), planeID(planeID), capacity(capacity), 
-          availableSeats(capacity), destination(destination), 
-          departureTime(departureTime), arrivalTime(arrivalTime), status("On Time") {
+    static string encode(const string& key, string_view payload, bool removed) {
+        uint32_t header[4] = {recordMagic, static_cast<uint32_t>(key.size()),
+                              removed ? tombstone : static_cast<uint32_t>(payload.size()),
+                              checksum(key, removed ? string_view() : payload)};
         
-        flightID = generateID("FL");
+        string record(reinterpret_cast<const char*>(header), headerSize);
+        record += key;
+        if (!removed) {
+            record.append(payload.data(), payload.size());
+        }
+        return record;
+    }
+
+    static uint64_t recordSize(const string& key, uint32_t length) {
+        return headerSize + key.size() + length;
+    }
+
+    void forgetLocked(const string& key) {
+        auto it = index.find(key);
+        if (it != index.end()) {
+            liveBytes -= recordSize(key, it->second.length);
+            index.erase(it);
+        }
+    }
+
+    bool scanSegment(uint32_t segment, uint64_t& intactBytes) {
+        ifstream file(segmentPath(segment), ios::binary);
+        stringstream buffer;
+        buffer << file.rdbuf();
+        string data = buffer.str();
         
-        calculateSeatLayout();
+        size_t position = 0;
+        while (data.size() - position >= headerSize) {
+            uint32_t header[4];
+            memcpy(header, data.data() + position, headerSize);
+            
+            size_t keyLength = header[1];
+            size_t payloadLength = header[2] == tombstone ? 0 : header[2];
+            if (header[0] != recordMagic || data.size() - position - headerSize < keyLength + payloadLength) {
+                break;
+            }
+            
+            string key = data.substr(position + headerSize, keyLength);
+            string_view payload(data.data() + position + headerSize + keyLength, payloadLength);
+            if (checksum(key, payload) != header[3]) {
+                break;
+            }
+            
+            forgetLocked(key);
+            if (header[2] != tombstone) {
+                index[key] = {segment, position + headerSize + keyLength, header[2]};
+                liveBytes += recordSize(key, header[2]);
+            }
+            position += headerSize + keyLength + payloadLength;
+        }
         
-        initializeSeatMap();
+        intactBytes = position;
+        totalBytes += position;
+        return position == data.size();
     }
 
-    void calculateSeatLayout() {
-        if (capacity < 60) {
-            seatsPerRow = 2;
-            totalColumns = 5;
+    ifstream* readerFor(uint32_t segment) {
+        unique_ptr<ifstream>& reader = readers[segment];
+        if (!reader) {
+            reader = make_unique<ifstream>(segmentPath(segment), ios::binary);
+        }
+        return reader->is_open() ? reader.get() : nullptr;
+    }
+
+    bool readLocked(const Location& location, string& payload) {
+        if (unflushed) {
+            writer.flush();
+            unflushed = false;
         }
-        else if (capacity < 150) {
-            seatsPerRow = 3;
-            totalColumns = 7;
+        
+        ifstream* reader = readerFor(location.segment);
+        if (reader == nullptr) {
+            return false;
         }
-        else {
-            seatsPerRow = 5;
-            totalColumns = 11;
+        
+        payload.resize(location.length);
+        reader->clear();
+        reader->seekg(static_cast<streamoff>(location.offset));
+        reader->read(&payload[0], location.length);
+        return static_cast<size_t>(reader->gcount()) == location.length;
+    }
+
+    void openWriterLocked(uint32_t segment) {
+        if (writer.is_open()) {
+            writer.close();
         }
+        activeSegment = segment;
+        writer.open(segmentPath(segment), ios::binary | ios::app);
+        segments.emplace(segment, 0);
     }
 
-    void initializeSeatMap() {
-        int seatsPerFullRow = totalColumns - 1;
-        int fullRows = capacity / seatsPerFullRow;
+    bool appendLocked(const string& key, string_view payload, bool removed) {
+        if (!opened) {
+            throw FileOperationException("Segment store is not open: " + directory);
+        }
         
-        int remainingSeats = capacity % seatsPerFullRow;
+        if (segments[activeSegment] >= segmentLimit) {
+            openWriterLocked(activeSegment + 1);
+        }
         
-        int totalRows = fullRows + (remainingSeats > 0 ? 1 : 0);
+        string record = encode(key, payload, removed);
+        writer.write(record.data(), record.size());
+        if (!writer) {
+            throw FileOperationException("Failed to append to " + segmentPath(activeSegment));
+        }
+        unflushed = true;
         
-        seatMap.resize(totalRows);
+        forgetLocked(key);
+        if (!removed) {
+            index[key] = {activeSegment, segments[activeSegment] + headerSize + key.size(),
+                          static_cast<uint32_t>(payload.size())};
+            liveBytes += record.size();
+        }
+        segments[activeSegment] += record.size();
+        totalBytes += record.size();
+        return true;
+    }
+
+    void migrateLegacyFiles() {
+        namespace fs = std::filesystem;
         
-        for (int i = 0; i < totalRows; i++) {
-            if (i == totalRows - 1 && remainingSeats > 0) {
-                seatMap[i].resize(totalColumns, false);
-                
-                int seatsLeft = remainingSeats;
-                int col = 0;
-                
-                while (col < seatsPerRow && seatsLeft > 0) {
-                    seatMap[i][col] = false;
-                    col++;
-                    seatsLeft--;
-                }
-                
-                col++;
-                
-                while (col < totalColumns && seatsLeft > 0) {
-                    seatMap[i][col] = false;
-                    col++;
-                    seatsLeft--;
-                }
-                
-                while (col < totalColumns) {
-                    seatMap[i][col] = true;
-                    col++;
-                }
-            } else {
-                seatMap[i].resize(totalColumns, false);
-                
-                if (totalColumns == 5) {
-                    seatMap[i][2] = true;
-                } else if (totalColumns == 7) {
-                    seatMap[i][3] = true;
-                } else if (totalColumns == 11) {
-                    seatMap[i][3] = true;
-                    seatMap[i][8] = true;
-                }
+        error_code error;
+        vector<fs::path> legacy;
+        for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+            if (it->path().extension() == ".txt") {
+                legacy.push_back(it->path());
             }
         }
         
-        int totalSeats = 0;
-        for (size_t i = 0; i < seatMap.size(); i++) {
-            for (size_t j = 0; j < seatMap[i].size(); j++) {
-                if ((totalColumns == 5 && j == 2) || 
-                    (totalColumns == 7 && j == 3) || 
-                    (totalColumns == 11 && (j == 3 || j == 8))) {
-                    continue;
-                }
-                
-                if (!seatMap[i][j]) {
-                    totalSeats++;
+        for (const auto& path : legacy) {
+            string key = path.stem().string();
+            if (index.find(key) == index.end()) {
+                ifstream file(path, ios::binary);
+                stringstream buffer;
+                buffer << file.rdbuf();
+                string payload = buffer.str();
+                if (!payload.empty()) {
+                    appendLocked(key, payload, false);
                 }
             }
         }
         
-        if (totalSeats > capacity) {
-            int excessSeats = totalSeats - capacity;
-            
-            for (int i = seatMap.size() - 1; i >= 0 && excessSeats > 0; i--) {
-                for (int j = seatMap[i].size() - 1; j >= 0 && excessSeats > 0; j--) {
-                    if ((totalColumns == 5 && j == 2) || 
-                        (totalColumns == 7 && j == 3) || 
-                        (totalColumns == 11 && (j == 3 || j == 8))) {
-                        continue;
-                    }
-                    
-                    if (!seatMap[i][j]) {
-                        seatMap[i][j] = true;
-                        excessSeats--;
-                    }
-                }
+        if (!legacy.empty()) {
+            writer.flush();
+            unflushed = false;
+            DatabaseManager::syncFile(segmentPath(activeSegment));
+            for (const auto& path : legacy) {
+                fs::remove(path, error);
             }
         }
     }
 
-    string getFlightID() const { return flightID; }
-    string getAirlineName() const { return airlineName; }
-    string getPlaneID() const { return planeID; }
-    int getCapacity() const { return capacity; }
-    int getAvailableSeats() const { return availableSeats; }
-    string getDestination() const { return destination; }
-    string getDepartureTime() const { return departureTime; }
-    string getArrivalTime() const { return arrivalTime; }
-    string getStatus() const { return status; }
+public:
+    explicit SegmentStore(const string& directory)
+        : directory(directory), activeSegment(1), liveBytes(0), totalBytes(0), unflushed(false), opened(false) {}
 
-    void setAirlineName(const string& name) { airlineName = name; }
-    void setPlaneID(const string& id) { planeID = id; }
-    void setCapacity(int cap) { 
-        capacity = cap; 
-        calculateSeatLayout();
-        initializeSeatMap();
+    static SegmentStore& seatMaps() {
+        static SegmentStore store("seatmaps");
+        return store;
     }
-    void setDestination(const string& dest) { destination = dest; }
-    void setDepartureTime(const string& time) { departureTime = time; }
-    void setArrivalTime(const string& time) { arrivalTime = time; }
-    void setStatus(const string& stat) { status = stat; }
 
-    pair<int, int> seatNumberToIndices(const string& seatNumber) const {
-        try {
-            if (seatNumber.length() < 2) {
-                throw ValidationException("Invalid seat number format");
-            }
-            
-            int row;
-            try {
-                row = stoi(seatNumber.substr(0, seatNumber.length() - 1)) - 1;
-            } catch (const invalid_argument&) {
-                throw ValidationException("Invalid row number in seat");
-            }
-            
-            char colLetter = toupper(seatNumber.back());
-            
-            int col;
-            if (colLetter >= 'A' && colLetter <= 'Z') {
-                col = colLetter - 'A';
-                
-                if (totalColumns == 5) {
-                    if (col >= 2) col++;
-                } else if (totalColumns == 7) {
-                    if (col >= 3) col++;
-                } else if (totalColumns == 11) {
-                    if (col >= 3 && col < 7) col++;
-                    else if (col >= 7) col += 2;
-                }
-            } else {
-                throw ValidationException("Invalid column letter in seat");
-            }
-            
-            return make_pair(row, col);
-        } catch (const exception& e) {
-            throw ValidationException(string("Error parsing seat number: ") + e.what());
-        }
+    static SegmentStore& waitingLists() {
+        static SegmentStore store("waitinglists");
+        return store;
+    }
+
+    static SegmentStore& archivedSeatMaps() {
+        static SegmentStore store("archive/seatmaps");
+        return store;
     }
 
-    string indicesToSeatNumber(int row, int col) const {
-        int adjustedCol = col;
-        if (totalColumns == 5) {
-            if (col > 2) adjustedCol--;
-        } else if (totalColumns == 7) {
-            if (col > 3) adjustedCol--;
-        } else if (totalColumns == 11) {
-            if (col > 3 && col <= 8) adjustedCol--;
-            else if (col > 8) adjustedCol -= 2;
+    static SegmentStore& archivedReservations() {
+        static SegmentStore store("archive/reservations");
+        return store;
+    }
+
+    void open() {
+        namespace fs = std::filesystem;
+        lock_guard<mutex> guard(storeMutex);
+        
+        if (writer.is_open()) {
+            writer.close();
         }
+        readers.clear();
+        index.clear();
+        segments.clear();
+        liveBytes = 0;
+        totalBytes = 0;
+        unflushed = false;
         
-        char colLetter = 'A' + adjustedCol;
-        return to_string(row + 1) + colLetter;
+        error_code error;
+        fs::create_directories(directory, error);
+        
+        vector<uint32_t> numbers;
+        for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+            string name = it->path().filename().string();
+            unsigned number = 0;
+            if (name.size() == 18 && sscanf(name.c_str(), "segment-%6u.dat", &number) == 1 && number > 0) {
+                numbers.push_back(number);
+            }
+        }
+        sort(numbers.begin(), numbers.end());
+        
+        bool intact = true;
+        for (uint32_t number : numbers) {
+            uint64_t size = 0;
+            intact = scanSegment(number, size);
+            segments[number] = size;
+        }
+        
+        uint32_t last = numbers.empty() ? 1 : numbers.back();
+        openWriterLocked(intact ? last : last + 1);
+        opened = true;
+        
+        migrateLegacyFiles();
     }
 
-    bool isSeatAvailable(const string& seatNumber) const {
-        try {
-            pair<int, int> indices = seatNumberToIndices(seatNumber);
-            int row = indices.first;
-            int col = indices.second;
-            
-            if (row < 0 || row >= seatMap.size() || col < 0 || col >= totalColumns) {
-                throw ValidationException("Seat number out of range");
-            }
-            
-            if ((totalColumns == 5 && col == 2) || 
-                (totalColumns == 7 && col == 3) || 
-                (totalColumns == 11 && (col == 3 || col == 8))) {
-                throw ValidationException("Cannot book an aisle");
-            }
-            
-            return !seatMap[row][col];
-        } catch (const exception& e) {
-            printErrorMessage("Error checking seat availability: " + string(e.what()));
+    bool isOpen() {
+        lock_guard<mutex> guard(storeMutex);
+        return opened;
+    }
+
+    bool contains(const string& key) {
+        lock_guard<mutex> guard(storeMutex);
+        return index.find(key) != index.end();
+    }
+
+    bool get(const string& key, string& payload) {
+        lock_guard<mutex> guard(storeMutex);
+        auto it = index.find(key);
+        return it != index.end() && readLocked(it->second, payload);
+    }
+
+    bool put(const string& key, string_view payload) {
+        lock_guard<mutex> guard(storeMutex);
+        return appendLocked(key, payload, false);
+    }
+
+    bool erase(const string& key) {
+        lock_guard<mutex> guard(storeMutex);
+        if (index.find(key) == index.end()) {
             return false;
         }
+        return appendLocked(key, string_view(), true);
     }
 
-    bool bookSeat(const string& seatNumber) {
-        try {
-            if (!isSeatAvailable(seatNumber)) {
-                throw BookingException("Seat " + seatNumber + " is not available");
-            }
-            
-            pair<int, int> indices = seatNumberToIndices(seatNumber);
-            int row = indices.first;
-            int col = indices.second;
-            
-            seatMap[row][col] = true;
-            availableSeats--;
-            
-            return true;
-        } catch (const exception& e) {
-            printErrorMessage("Error booking seat: " + string(e.what()));
-            return false;
+    void flush() {
+        lock_guard<mutex> guard(storeMutex);
+        if (unflushed) {
+            writer.flush();
+            unflushed = false;
         }
     }
 
-    bool cancelSeat(const string& seatNumber) {
-        try {
-            pair<int, int> indices = seatNumberToIndices(seatNumber);
-            int row = indices.first;
-            int col = indices.second;
-            
-            if (row < 0 || row >= seatMap.size() || col < 0 || col >= totalColumns) {
-                throw ValidationException("Seat number out of range");
-            }
-            
-            if ((totalColumns == 5 && col == 2) || 
-                (totalColumns == 7 && col == 3) || 
-                (totalColumns == 11 && (col == 3 || col == 8))) {
-                throw ValidationException("Cannot cancel an aisle");
-            }
-            
-            if (!seatMap[row][col]) {
-                throw BookingException("Seat " + seatNumber + " is already available");
+    bool sync() {
+        lock_guard<mutex> guard(storeMutex);
+        writer.flush();
+        unflushed = false;
+        return DatabaseManager::syncFile(segmentPath(activeSegment));
+    }
+
+    void forEach(const function<void(const string&, string_view)>& visit) {
+        lock_guard<mutex> guard(storeMutex);
+        
+        vector<pair<Location, const string*>> live;
+        live.reserve(index.size());
+        for (const auto& entry : index) {
+            live.emplace_back(entry.second, &entry.first);
+        }
+        sort(live.begin(), live.end(), [](const auto& a, const auto& b) {
+            return a.first.segment != b.first.segment ? a.first.segment < b.first.segment
+                                                      : a.first.offset < b.first.offset;
+        });
+        
+        string payload;
+        for (const auto& entry : live) {
+            if (readLocked(entry.first, payload)) {
+                visit(*entry.second, payload);
             }
-            
-            seatMap[row][col] = false;
-            availableSeats++;
-            
-            return true;
-        } catch (const exception& e) {
-            printErrorMessage("Error canceling seat: " + string(e.what()));
-            return false;
         }
     }
 
-    void displaySeatMap() const {
-        printSubHeader("Seat Map for Flight " + flightID + " (" + airlineName + ")");
+    bool compactIfWorthwhile() {
+        namespace fs = std::filesystem;
+        lock_guard<mutex> guard(storeMutex);
         
-        cout << "  Destination: " << destination << "\n";
-        cout << "  Available Seats: " << availableSeats << " out of " << capacity << "\n\n";
+        if (!opened || totalBytes < segmentLimit || liveBytes * 2 > totalBytes) {
+            return false;
+        }
         
-        cout << "    ";
-        char seatLetter = 'A';
-        for (int j = 0; j < totalColumns; j++) {
-            if ((totalColumns == 5 && j == 2) || 
-                (totalColumns == 7 && j == 3) || 
-                (totalColumns == 11 && (j == 3 || j == 8))) {
-                cout << "    ";
-            } else {
-                cout << seatLetter << "   ";
-                seatLetter++;
+        vector<pair<string, string>> live;
+        live.reserve(index.size());
+        for (const auto& entry : index) {
+            string payload;
+            if (!readLocked(entry.second, payload)) {
+                return false;
             }
+            live.emplace_back(entry.first, std::move(payload));
         }
-        cout << "\n";
         
-        for (size_t i = 0; i < seatMap.size(); i++) {
-            cout << setw(2) << i + 1 << "  ";
-            
-            for (size_t j = 0; j < seatMap[i].size(); j++) {
-                if ((totalColumns == 5 && j == 2) || 
-                    (totalColumns == 7 && j == 3) || 
-                    (totalColumns == 11 && (j == 3 || j == 8))) {
-                    cout << "|   ";
-                } else {
-                    if (j < seatMap[i].size()) {
-                        if (seatMap[i][j]) {
-                            cout << "X   ";
-                        } else {
-                            cout << "O   ";
-                        }
-                    }
-                }
+        vector<uint32_t> retired;
+        for (const auto& segment : segments) {
+            retired.push_back(segment.first);
+        }
+        
+        openWriterLocked(activeSegment + 1);
+        index.clear();
+        liveBytes = 0;
+        totalBytes = 0;
+        for (const auto& segment : retired) {
+            segments.erase(segment);
+        }
+        segments[activeSegment] = 0;
+        
+        for (const auto& entry : live) {
+            appendLocked(entry.first, entry.second, false);
+        }
+        writer.flush();
+        unflushed = false;
+        if (!writer) {
+            throw FileOperationException("Failed to compact " + directory);
+        }
+        for (const auto& segment : segments) {
+            if (!DatabaseManager::syncFile(segmentPath(segment.first))) {
+                throw FileOperationException("Failed to compact " + directory);
             }
-            cout << "\n";
         }
+        DatabaseManager::syncDirectoryOf(segmentPath(activeSegment));
         
-        cout << "\n";
-        cout << "  O - Available  ";
-        cout << "X - Occupied  ";
-        cout << "| - Aisle\n";
+        readers.clear();
+        error_code error;
+        for (uint32_t segment : retired) {
+            fs::remove(segmentPath(segment), error);
+        }
+        return true;
     }
 
-    string getFirstAvailableSeat() const {
-        for (size_t i = 0; i < seatMap.size(); i++) {
-            for (size_t j = 0; j < seatMap[i].size(); j++) {
-                if ((totalColumns == 5 && j == 2) || 
-                    (totalColumns == 7 && j == 3) || 
-                    (totalColumns == 11 && (j == 3 || j == 8))) {
-                    continue;
-                }
-                
-                if (!seatMap[i][j]) {
-                    return indicesToSeatNumber(i, j);
-                }
+    size_t size() {
+        lock_guard<mutex> guard(storeMutex);
+        return index.size();
+    }
+};
+
+class IdSequence {
+private:
+    static constexpr int firstValue = 10000;
+
+    static shared_mutex countersMutex;
+    static map<string, unique_ptr<atomic<int>>> counters;
+
+    static atomic<int>& counterFor(const string& prefix) {
+        {
+            shared_lock<shared_mutex> guard(countersMutex);
+            auto it = counters.find(prefix);
+            if (it != counters.end()) {
+                return *it->second;
             }
         }
-        return "";
+        
+        unique_lock<shared_mutex> guard(countersMutex);
+        unique_ptr<atomic<int>>& counter = counters[prefix];
+        if (!counter) {
+            counter = make_unique<atomic<int>>(firstValue);
+        }
+        return *counter;
     }
 
-    bool isFullyBooked() const {
-        return availableSeats == 0;
+public:
+    static void observe(const string& prefix, int value) {
+        atomic<int>& counter = counterFor(prefix);
+        int current = counter.load();
+        while (value > current && !counter.compare_exchange_weak(current, value)) {
+        }
     }
 
-    void saveToFile() const {
-        try {
-            DatabaseManager* dbManager = DatabaseManager::getInstance();
-            
-            stringstream ss;
-            ss << flightID << ","
-               << airlineName << ","
-               << planeID << ","
-               << capacity << ","
-               << availableSeats << ","
-               << destination << ","
-               << departureTime << ","
-               << arrivalTime << ","
-               << status;
-            
-            dbManager->saveData("flights.txt", ss.str());
-            
-            stringstream seatSS;
-            for (size_t i = 0; i < seatMap.size(); i++) {
-                for (size_t j = 0; j < seatMap[i].size(); j++) {
-                    seatSS << (seatMap[i][j] ? "1" : "0") << ",";
-                }
-                seatSS << "\n";
-            }
-            
-            dbManager->saveDataOverwrite("seatmaps/" + flightID + ".txt", seatSS.str());
-        } catch (const exception& e) {
-            printErrorMessage("Error saving flight: " + string(e.what()));
-        }
+    static void observeID(const string& prefix, const string& id);
+    static void seed();
+    static void save();
+
+    static string next(const string& prefix) {
+        return prefix + to_string(counterFor(prefix).fetch_add(1) + 1);
     }
+};
 
-    static void loadFlights() {
-        try {
-            flights.clear();
-            
-            DatabaseManager* dbManager = DatabaseManager::getInstance();
-            string fileContent = dbManager->loadData("flights.txt");
-            
-            if (fileContent.empty()) {
-                return;
-            }
-            
-            istringstream fileStream(fileContent);
-            string line;
-            
-            while (getline(fileStream, line)) {
-                if (line.empty()) {
-                    continue;
-                }
-                
-                vector<string> fields;
-                string field;
-                bool inQuotes = false;
-                
-                for (size_t i = 0; i < line.length(); i++) {
-                    char c = line[i];
-                    
-                    if (c == '"') {
-                        inQuotes = !inQuotes;
-                    } else if (c == ',' && !inQuotes) {
-                        fields.push_back(field);
-                        field.clear();
-                    } else {
-                        field += c;
-                    }
-                }
-                
-                fields.push_back(field);
-                
-                if (fields.size() < 9) {
-                    printErrorMessage("Invalid flight data format: " + line);
-                    continue;
-                }
-                
-                Flight flight;
-                flight.flightID = fields[0];
-                flight.airlineName = fields[1];
-                flight.planeID = fields[2];
-                
-                try {
-                    flight.capacity = stoi(fields[3]);
-                    flight.availableSeats = stoi(fields[4]);
-                } catch (const exception& e) {
-                    printErrorMessage("Error parsing numeric flight data: " + string(e.what()));
-                    continue;
-                }
-                
-                flight.destination = fields[5];
-                
-                if (fields[6].find(" - ") == string::npos) {
-                    flight.departureTime = "May 10, 2025 - 08:00 AM";
-                } else {
-                    flight.departureTime = fields[6];
-                }
-                
-                if (fields[7].find("May 10, 2025") == string::npos) {
-                    flight.arrivalTime = "May 10, 2025 - 10:00 AM";
-                } else {
-                    flight.arrivalTime = fields[7];
-                }
-                
-                if (fields[8] == "may 10") {
-                    flight.status = "On Time";
-                } else {
-                    flight.status = fields[8];
-                }
-                
-                flight.calculateSeatLayout();
-                
-                flight.seatMap.clear();
-                string seatData = dbManager->loadData("seatmaps/" + flight.flightID + ".txt");
-                stringstream seatStream(seatData);
-                string seatLine;
-                
-                while (getline(seatStream, seatLine)) {
-                    stringstream seatSS(seatLine);
-                    string seatToken;
-                    vector<bool> row;
-                    
-                    while (getline(seatSS, seatToken, ',')) {
-                        if (!seatToken.empty()) {
-                            row.push_back(seatToken == "1");
-                        }
-                    }
-                    
-                    if (!row.empty()) {
-                        flight.seatMap.push_back(row);
-                    }
-                }
-                
-                if (flight.seatMap.empty()) {
-                    flight.initializeSeatMap();
-                }
-                
-                flights.push_back(flight);
-            }
-        } catch (const exception& e) {
-            printErrorMessage("Error loading flights: " + string(e.what()));
-        }
+shared_mutex IdSequence::countersMutex;
+map<string, unique_ptr<atomic<int>>> IdSequence::counters;
+
+string generateID(const string& prefix) {
+    return IdSequence::next(prefix);
+}
+
+bool parseInt(string_view text, int& value) {
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    auto result = from_chars(first, last, value);
+    return !text.empty() && result.ec == errc() && result.ptr == last;
+}
+
+void IdSequence::observeID(const string& prefix, const string& id) {
+    int value;
+    if (id.compare(0, prefix.size(), prefix) == 0 && parseInt(string_view(id).substr(prefix.size()), value)) {
+        observe(prefix, value);
     }
+}
 
-    static void saveAllFlights() {
-        try {
-            ofstream file("flights.txt", ios::trunc);
-            file.close();
-            
-            for (const auto& flight : flights) {
-                flight.saveToFile();
-            }
-        } catch (const exception& e) {
-            printErrorMessage("Error saving all flights: " + string(e.what()));
-        }
+void Metrics::configure() {
+    const char* metrics = getenv("AIRLINE_METRICS");
+    if (metrics != nullptr && *metrics != '\0') {
+        setEnabled(strcmp(metrics, "0") != 0);
     }
-};
+    
+    const char* trace = getenv("AIRLINE_TRACE");
+    if (trace != nullptr && *trace != '\0') {
+        setTracing(strcmp(trace, "0") != 0);
+    }
+    
+    const char* interval = getenv("AIRLINE_METRICS_DUMP");
+    int seconds = 0;
+    if (interval != nullptr && parseInt(interval, seconds) && seconds > 0) {
+        dumpInterval = seconds;
+        nextDump = chrono::steady_clock::now() + chrono::seconds(seconds);
+    }
+    
+    const char* file = getenv("AIRLINE_METRICS_FILE");
+    if (file != nullptr && *file != '\0') {
+        dumpFile = file;
+    }
+}
 
-class Reservation {
-private:
-    string reservationID;
-    string passengerName;
-    string flightID;
-    string airlineName;
-    string destination;
-    string seatNumber;
-    string status;
-    string username;
-    string paymentMethod;
+bool Metrics::dump() {
+    if (dumpInterval <= 0 || !enabled()) {
+        return false;
+    }
+    
+    nextDump = chrono::steady_clock::now() + chrono::seconds(dumpInterval);
+    return DatabaseManager::getInstance()->writeAtomically(dumpFile, renderPrometheus());
+}
 
-public:
-    Reservation() {}
+void Metrics::dumpIfDue() {
+    if (dumpInterval > 0 && chrono::steady_clock::now() >= nextDump) {
+        dump();
+    }
+}
 
-    Reservation(const string& passengerName, const string& flightID, 
-                const string& airlineName, const string& destination, 
-                const string& seatNumber, const string& username,
-                const string& paymentMethod = "")
-        : passengerName(passengerName), flightID(flightID), 
-          airlineName(airlineName), destination(destination), 
-          seatNumber(seatNumber), status("Confirmed"), username(username),
-          paymentMethod(paymentMethod) {
+class WorkerPool {
+private:
+    struct Batch {
+        size_t remaining;
+        exception_ptr failure;
+    };
+
+    struct Job {
+        Batch* batch;
+        const function<void(size_t)>* task;
+        size_t index;
+    };
+
+    static mutex queueMutex;
+    static condition_variable queueChanged;
+    static deque<Job> pending;
+    static vector<thread> workers;
+    static bool running;
+
+    static void execute(unique_lock<mutex>& guard) {
+        Job job = pending.front();
+        pending.pop_front();
+        guard.unlock();
         
-        reservationID = generateID("RES");
+        exception_ptr failure;
+        try {
+            (*job.task)(job.index);
+        } catch (...) {
+            failure = current_exception();
+        }
+        
+        guard.lock();
+        if (failure && !job.batch->failure) {
+            job.batch->failure = failure;
+        }
+        if (--job.batch->remaining == 0) {
+            queueChanged.notify_all();
+        }
     }
 
-    string getReservationID() const { return reservationID; }
-    string getPassengerName() const { return passengerName; }
-    string getFlightID() const { return flightID; }
-    string getAirlineName() const { return airlineName; }
-    string getDestination() const { return destination; }
-    string getSeatNumber() const { return seatNumber; }
-    string getStatus() const { return status; }
-    string getUsername() const { return username; }
-    string getPaymentMethod() const { return paymentMethod; }
+    static void process() {
+        unique_lock<mutex> guard(queueMutex);
+        while (true) {
+            queueChanged.wait(guard, [] { return !running || !pending.empty(); });
+            if (pending.empty()) {
+                return;
+            }
+            execute(guard);
+        }
+    }
 
-    void saveToFile() const {
-        try {
-            DatabaseManager* dbManager = DatabaseManager::getInstance();
-            
-            stringstream ss;
-            ss << reservationID << ","
-               << passengerName << ","
-               << flightID << ","
-               << airlineName << ","
-               << destination << ","
-               << seatNumber << ","
-               << status << ","
-               << username << ","
-               << paymentMethod;
-            
-            dbManager->saveData("reservations.txt", ss.str());
-        } catch (const exception& e) {
-            printErrorMessage("Error saving reservation: " + string(e.what()));
+public:
+    static size_t concurrency() {
+        static const size_t configured = [] {
+            int parsed = 0;
+            const char* value = getenv("AIRLINE_LOAD_THREADS");
+            if (value != nullptr && parseInt(value, parsed) && parsed > 0) {
+                return static_cast<size_t>(parsed);
+            }
+            return static_cast<size_t>(max(1u, min(thread::hardware_concurrency(), 16u)));
+        }();
+        return configured;
+    }
+
+    static void start() {
+        lock_guard<mutex> guard(queueMutex);
+        if (running) {
+            return;
+        }
+        running = true;
+        for (size_t i = 1; i < concurrency(); i++) {
+            workers.emplace_back(process);
         }
     }
 
-    static void loadReservations() {
-        try {
-            reservations.clear();
-            
-            DatabaseManager* dbManager = DatabaseManager::getInstance();
-            string data = dbManager->loadData("reservations.txt");
-            
-            stringstream dataStream(data);
-            string line;
-            
-            while (getline(dataStream, line)) {
-                stringstream ss(line);
-                string token;
-                vector<string> tokens;
-                
-                while (getline(ss, token, ',')) {
-                    tokens.push_back(token);
-                }
-                
-                if (tokens.size() >= 8) {
-                    Reservation reservation;
-                    reservation.reservationID = tokens[0];
-                    reservation.passengerName = tokens[1];
-                    reservation.flightID = tokens[2];
-                    reservation.airlineName = tokens[3];
-                    reservation.destination = tokens[4];
-                    reservation.seatNumber = tokens[5];
-                    reservation.status = tokens[6];
-                    reservation.username = tokens[7];
-                    
-                    if (tokens.size() >= 9) {
-                        reservation.paymentMethod = tokens[8];
-                    }
-                    
-                    reservations.push_back(reservation);
-                }
+    static void stop() {
+        {
+            lock_guard<mutex> guard(queueMutex);
+            if (!running) {
+                return;
             }
-        } catch (const exception& e) {
-            printErrorMessage("Error loading reservations: " + string(e.what()));
+            running = false;
         }
+        queueChanged.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
     }
 
-    static void saveAllReservations() {
-        try {
-            ofstream file("reservations.txt", ios::trunc);
-            file.close();
-            
-            for (const auto& reservation : reservations) {
-                reservation.saveToFile();
+    static void run(size_t count, const function<void(size_t)>& task) {
+        if (count == 0) {
+            return;
+        }
+        
+        unique_lock<mutex> guard(queueMutex);
+        if (workers.empty() || count == 1) {
+            guard.unlock();
+            for (size_t i = 0; i < count; i++) {
+                task(i);
+            }
+            return;
+        }
+        
+        Batch batch = {count, nullptr};
+        for (size_t i = 0; i < count; i++) {
+            pending.push_back({&batch, &task, i});
+        }
+        queueChanged.notify_all();
+        
+        while (batch.remaining > 0) {
+            if (!pending.empty()) {
+                execute(guard);
+            } else {
+                queueChanged.wait(guard);
             }
-        } catch (const exception& e) {
-            printErrorMessage("Error saving all reservations: " + string(e.what()));
         }
+        
+        if (batch.failure) {
+            rethrow_exception(batch.failure);
+        }
+    }
+
+    static void run(const vector<function<void()>>& tasks) {
+        run(tasks.size(), [&tasks](size_t index) { tasks[index](); });
     }
 };
 
-class WaitingList {
+mutex WorkerPool::queueMutex;
+condition_variable WorkerPool::queueChanged;
+deque<WorkerPool::Job> WorkerPool::pending;
+vector<thread> WorkerPool::workers;
+bool WorkerPool::running = false;
+
+template <typename T>
+vector<T> concatenateChunks(vector<vector<T>>& chunks) {
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.size();
+    }
+    
+    vector<T> joined = chunks.empty() ? vector<T>() : std::move(chunks[0]);
+    if (joined.size() == total) {
+        return joined;
+    }
+    
+    joined.reserve(total);
+    for (size_t i = 1; i < chunks.size(); i++) {
+        move(chunks[i].begin(), chunks[i].end(), back_inserter(joined));
+    }
+    return joined;
+}
+
+class CsvRecord {
 private:
-    string flightID;
-    vector<pair<string, string>> passengers;
+    vector<string_view> fields;
+    deque<string> unescaped;
 
-public:
-    WaitingList() {}
+    friend class CsvReader;
 
-    WaitingList(const string& flightID) : flightID(flightID) {}
+public:
+    size_t size() const { return fields.size(); }
+    bool empty() const { return fields.empty(); }
+    string_view operator[](size_t index) const { return fields[index]; }
+    const vector<string_view>& getFields() const { return fields; }
 
-    void addPassenger(const string& username, const string& passengerName) {
-        passengers.push_back(make_pair(username, passengerName));
+    string str(size_t index) const {
+        return index < fields.size() ? string(fields[index]) : string();
     }
 
-    bool removePassenger(const string& username) {
-        for (auto it = passengers.begin(); it != passengers.end(); ++it) {
-            if (it->first == username) {
-                passengers.erase(it);
-                return true;
-            }
-        }
-        return false;
+    vector<string> toStrings() const {
+        return vector<string>(fields.begin(), fields.end());
     }
+};
 
-    pair<string, string> getNextPassenger() const {
-        if (passengers.empty()) {
-            return make_pair("", "");
-        }
-        return passengers.front();
-    }
+class CsvReader {
+private:
+    string_view data;
+    size_t position;
 
-    bool isEmpty() const {
-        return passengers.empty();
+    bool atLineEnd() const {
+        return position >= data.size() || data[position] == '\n' || data[position] == '\r';
     }
 
-    void display() const {
-        printSubHeader("Waiting List for Flight " + flightID);
+    string_view readQuoted(CsvRecord& record) {
+        size_t start = ++position;
+        bool escaped = false;
         
-        if (passengers.empty()) {
-            printInfoMessage("No passengers in the waiting list.");
-            return;
+        while (position < data.size()) {
+            if (data[position] == '"') {
+                if (position + 1 < data.size() && data[position + 1] == '"') {
+                    escaped = true;
+                    position += 2;
+                    continue;
+                }
+                break;
+            }
+            position++;
         }
         
-        vector<pair<string, int>> columns = {
-            {"No.", 5},
-            {"Passenger Name", 25},
-            {"Username", 20}
-        };
+        string_view field = data.substr(start, min(position, data.size()) - start);
+        if (position < data.size()) {
+            position++;
+        }
         
-        printTableHeader(columns);
+        while (!atLineEnd() && data[position] != ',') {
+            position++;
+        }
+        
+        if (!escaped) {
+            return field;
+        }
         
-        for (size_t i = 0; i < passengers.size(); i++) {
-            cout << setw(5) << i + 1 
-                 << setw(25) << passengers[i].second 
-                 << setw(20) << passengers[i].first << "\n";
+        string value;
+        value.reserve(field.size());
+        for (size_t i = 0; i < field.size(); i++) {
+            value += field[i];
+            if (field[i] == '"') {
+                i++;
+            }
         }
+        record.unescaped.push_back(std::move(value));
+        return record.unescaped.back();
     }
 
-    void saveToFile() const {
-        try {
-            DatabaseManager* dbManager = DatabaseManager::getInstance();
-            
-            if (passengers.empty()) {
-                dbManager->deleteFile("waitinglists/" + flightID + ".txt");
-                return;
+public:
+    static constexpr size_t minimumChunkSize = 64 * 1024;
+
+    explicit CsvReader(string_view data) : data(data), position(0) {}
+
+    static vector<size_t> chunkBoundaries(string_view data, size_t chunkCount) {
+        chunkCount = max<size_t>(1, min(chunkCount, data.size() / minimumChunkSize));
+        
+        vector<size_t> boundaries = {0};
+        bool inQuotes = false;
+        size_t position = 0;
+        for (size_t chunk = 1; chunk < chunkCount && position < data.size(); chunk++) {
+            size_t goal = data.size() / chunkCount * chunk;
+            while (position < data.size() && (position < goal || inQuotes || data[position] != '\n')) {
+                if (data[position] == '"') {
+                    inQuotes = !inQuotes;
+                }
+                position++;
             }
             
-            stringstream ss;
-            for (const auto& passenger : passengers) {
-                ss << passenger.first << "," << passenger.second << "\n";
+            if (position < data.size()) {
+                boundaries.push_back(++position);
             }
-            
-            ofstream file("waitinglists/" + flightID + ".txt", ios::trunc);
-            file.close();
-            
-            dbManager->saveData("waitinglists/" + flightID + ".txt", ss.str());
-        } catch (const exception& e) {
-            printErrorMessage("Error saving waiting list: " + string(e.what()));
         }
+        
+        if (boundaries.back() != data.size()) {
+            boundaries.push_back(data.size());
+        }
+        return boundaries;
     }
 
-    static void loadWaitingLists() {
-        try {
-            waitingLists.clear();
-            
-            for (const auto& flight : flights) {
-                string flightID = flight.getFlightID();
-                WaitingList waitingList(flightID);
-                
-                DatabaseManager* dbManager = DatabaseManager::getInstance();
-                string data = dbManager->loadData("waitinglists/" + flightID + ".txt");
-                
-                stringstream dataStream(data);
-                string line;
-                
-                while (getline(dataStream, line)) {
-                    stringstream ss(line);
-                    string username, passengerName;
-                    
-                    getline(ss, username, ',');
-                    getline(ss, passengerName);
-                    
-                    waitingList.addPassenger(username, passengerName);
+    bool next(CsvRecord& record) {
+        record.fields.clear();
+        record.unescaped.clear();
+        
+        while (position < data.size() && (data[position] == '\n' || data[position] == '\r')) {
+            position++;
+        }
+        if (position >= data.size()) {
+            return false;
+        }
+        
+        while (true) {
+            if (position < data.size() && data[position] == '"') {
+                record.fields.push_back(readQuoted(record));
+            } else {
+                size_t start = position;
+                while (!atLineEnd() && data[position] != ',') {
+                    position++;
                 }
-                
-                waitingLists[flightID] = waitingList;
+                record.fields.push_back(data.substr(start, position - start));
             }
-        } catch (const exception& e) {
-            printErrorMessage("Error loading waiting lists: " + string(e.what()));
-        }
-    }
-
-    static void saveAllWaitingLists() {
-        try {
-            for (auto& pair : waitingLists) {
-                pair.second.saveToFile();
+            
+            if (position < data.size() && data[position] == ',') {
+                position++;
+                continue;
             }
-        } catch (const exception& e) {
-            printErrorMessage("Error saving all waiting lists: " + string(e.what()));
+            break;
         }
+        
+        if (position < data.size() && data[position] == '\r') {
+            position++;
+        }
+        if (position < data.size() && data[position] == '\n') {
+            position++;
+        }
+        return true;
     }
 };
 
-class Admin;
-class Customer;
-
-class User {
-private:
-    string username;
-    string password;
-    string name;
+bool DatabaseManager::forEachRecord(const string& filename, const function<void(const CsvRecord&)>& visit) {
+    METRIC_SPAN("db_scan");
+    CsvRecord record;
+    
+#ifdef _WIN32
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    const size_t chunkSize = 64 * 1024;
+    string pending;
+    vector<char> chunk(chunkSize);
+    bool inQuotes = false;
+    size_t scanned = 0;
+    
+    while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0) {
+        pending.append(chunk.data(), static_cast<size_t>(file.gcount()));
+        
+        size_t boundary = string::npos;
+        for (size_t i = scanned; i < pending.size(); i++) {
+            if (pending[i] == '"') {
+                inQuotes = !inQuotes;
+            } else if (pending[i] == '\n' && !inQuotes) {
+                boundary = i + 1;
+            }
+        }
+        scanned = pending.size();
+        
+        if (boundary == string::npos) {
+            continue;
+        }
+        
+        CsvReader reader(string_view(pending.data(), boundary));
+        while (reader.next(record)) {
+            visit(record);
+        }
+        
+        pending.erase(0, boundary);
+        scanned = pending.size();
+        inQuotes = false;
+        for (char c : pending) {
+            if (c == '"') {
+                inQuotes = !inQuotes;
+            }
+        }
+    }
+    
+    CsvReader reader(pending);
+    while (reader.next(record)) {
+        visit(record);
+    }
+    return true;
+#else
+    if (!fileExists(filename)) {
+        return false;
+    }
+    
+    MappedFile mapped;
+    if (!mapped.open(filename)) {
+        return true;
+    }
+    
+    madvise(const_cast<unsigned char*>(mapped.data()), mapped.size(), MADV_SEQUENTIAL);
+    
+    CsvReader reader(string_view(reinterpret_cast<const char*>(mapped.data()), mapped.size()));
+    while (reader.next(record)) {
+        visit(record);
+    }
+    return true;
+#endif
+}
+
+bool DatabaseManager::forEachRecordParallel(const string& filename, size_t chunkCount,
+                                            const function<void(size_t, const CsvRecord&)>& visit,
+                                            const function<void(size_t, size_t)>& prepare) {
+    METRIC_SPAN("db_scan_parallel");
+    if (!fileExists(filename)) {
+        return false;
+    }
+    
+#ifdef _WIN32
+    string contents = loadData(filename);
+    string_view data(contents);
+#else
+    MappedFile mapped;
+    if (!mapped.open(filename)) {
+        return true;
+    }
+    
+    string_view data(reinterpret_cast<const char*>(mapped.data()), mapped.size());
+#endif
+    
+    vector<size_t> boundaries = CsvReader::chunkBoundaries(data, chunkCount);
+    WorkerPool::run(boundaries.size() - 1, [&](size_t chunk) {
+        string_view slice = data.substr(boundaries[chunk], boundaries[chunk + 1] - boundaries[chunk]);
+        if (prepare) {
+            prepare(chunk, count(slice.begin(), slice.end(), '\n') + 1);
+        }
+        
+        CsvReader reader(slice);
+        CsvRecord record;
+        while (reader.next(record)) {
+            visit(chunk, record);
+        }
+    });
+    return true;
+}
+
+vector<string> splitCsvLine(string_view line) {
+    CsvReader reader(line);
+    CsvRecord record;
+    if (!reader.next(record)) {
+        return {};
+    }
+    return record.toStrings();
+}
+
+string quoteField(const string& value) {
+    if (value.find_first_of(",\"\r\n") == string::npos) {
+        return value;
+    }
+    
+    string quoted = "\"";
+    for (char c : value) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+inline int countTrailingZeros(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+template <typename T>
+class CopyableAtomic {
+private:
+    atomic<T> value;
+
+public:
+    CopyableAtomic(T initial = T()) : value(initial) {}
+    CopyableAtomic(const CopyableAtomic& other) noexcept : value(other.load()) {}
+
+    CopyableAtomic& operator=(const CopyableAtomic& other) noexcept {
+        value.store(other.load(), memory_order_release);
+        return *this;
+    }
+
+    CopyableAtomic& operator=(T desired) {
+        value.store(desired, memory_order_release);
+        return *this;
+    }
+
+    operator T() const { return load(); }
+
+    T load() const { return value.load(memory_order_acquire); }
+    T fetchAdd(T delta) { return value.fetch_add(delta, memory_order_acq_rel); }
+    T fetchSub(T delta) { return value.fetch_sub(delta, memory_order_acq_rel); }
+};
+
+class InternPool {
+private:
+    static shared_mutex poolMutex;
+    static deque<string> arena;
+    static unordered_map<string_view, const string*> index;
+
+public:
+    static const string* intern(string_view text) {
+        {
+            shared_lock<shared_mutex> guard(poolMutex);
+            auto it = index.find(text);
+            if (it != index.end()) {
+                return it->second;
+            }
+        }
+        
+        unique_lock<shared_mutex> guard(poolMutex);
+        auto it = index.find(text);
+        if (it != index.end()) {
+            return it->second;
+        }
+        
+        arena.emplace_back(text);
+        const string* stored = &arena.back();
+        index.emplace(string_view(*stored), stored);
+        return stored;
+    }
+
+    static const string* empty() {
+        static const string* blank = intern("");
+        return blank;
+    }
+
+    static size_t size() {
+        shared_lock<shared_mutex> guard(poolMutex);
+        return arena.size();
+    }
+};
+
+shared_mutex InternPool::poolMutex;
+deque<string> InternPool::arena;
+unordered_map<string_view, const string*> InternPool::index;
+
+class InternedString {
+private:
+    const string* value;
+
+public:
+    InternedString() : value(InternPool::empty()) {}
+    InternedString(string_view text) : value(InternPool::intern(text)) {}
+    InternedString(const string& text) : value(InternPool::intern(text)) {}
+    InternedString(const char* text) : value(InternPool::intern(text)) {}
+
+    const string& str() const { return *value; }
+    operator const string&() const { return *value; }
+
+    bool operator==(const InternedString& other) const { return value == other.value; }
+    bool operator!=(const InternedString& other) const { return value != other.value; }
+};
+
+class ScheduleClock {
+private:
+    struct Entry {
+        const string* text;
+        size_t dateLength;
+    };
+
+    static shared_mutex cacheMutex;
+    static unordered_map<int64_t, Entry> cache;
+
+    static Entry render(int64_t minute) {
+        static const char* const monthNames[] = {"January", "February", "March", "April", "May", "June",
+                                                 "July", "August", "September", "October", "November", "December"};
+        
+        int64_t days = minute >= 0 ? minute / 1440 : (minute - 1439) / 1440;
+        int minuteOfDay = static_cast<int>(minute - days * 1440);
+        
+        int year, month, day;
+        civilFromDays(days, year, month, day);
+        
+        int hour = minuteOfDay / 60;
+        string meridiem = hour >= 12 ? "PM" : "AM";
+        hour = hour % 12 == 0 ? 12 : hour % 12;
+        
+        string date = string(monthNames[month - 1]) + " " + to_string(day) + ", " + to_string(year);
+        
+        char clock[16];
+        snprintf(clock, sizeof(clock), "%02d:%02d %s", hour, minuteOfDay % 60, meridiem.c_str());
+        
+        return Entry{InternPool::intern(date + " - " + clock), date.size()};
+    }
+
+    static Entry lookup(int64_t epochSeconds) {
+        int64_t minute = epochSeconds >= 0 ? epochSeconds / 60 : (epochSeconds - 59) / 60;
+        {
+            shared_lock<shared_mutex> guard(cacheMutex);
+            auto it = cache.find(minute);
+            if (it != cache.end()) {
+                return it->second;
+            }
+        }
+        
+        Entry entry = render(minute);
+        unique_lock<shared_mutex> guard(cacheMutex);
+        return cache.emplace(minute, entry).first->second;
+    }
+
+public:
+    static const string& format(int64_t epochSeconds) {
+        if (epochSeconds == unknownScheduleTime) {
+            return *InternPool::empty();
+        }
+        return *lookup(epochSeconds).text;
+    }
+
+    static string_view date(int64_t epochSeconds) {
+        if (epochSeconds == unknownScheduleTime) {
+            return string_view();
+        }
+        Entry entry = lookup(epochSeconds);
+        return string_view(*entry.text).substr(0, entry.dateLength);
+    }
+
+    static string_view clock(int64_t epochSeconds) {
+        if (epochSeconds == unknownScheduleTime) {
+            return string_view();
+        }
+        Entry entry = lookup(epochSeconds);
+        return string_view(*entry.text).substr(entry.dateLength + 3);
+    }
+
+    static int64_t now() {
+        time_t current = time(0);
+        tm* local = localtime(&current);
+        return ((daysFromCivil(local->tm_year + 1900, local->tm_mon + 1, local->tm_mday) * 24 +
+                 local->tm_hour) * 60 + local->tm_min) * 60 + local->tm_sec;
+    }
+};
+
+shared_mutex ScheduleClock::cacheMutex;
+unordered_map<int64_t, ScheduleClock::Entry> ScheduleClock::cache;
+
+string getCurrentDateTime() {
+    return ScheduleClock::format(ScheduleClock::now());
+}
+
+class SeatMap {
+private:
+    int rows;
+    int seatsPerRow;
+    size_t wordCount;
+    unique_ptr<atomic<uint64_t>[]> words;
+    unique_ptr<atomic<uint16_t>[]> rowFree;
+
+    void allocate(int rowCount, int seatsInRow) {
+        rows = rowCount;
+        seatsPerRow = seatsInRow;
+        wordCount = (static_cast<size_t>(rows) * seatsPerRow + 63) / 64;
+        words.reset(wordCount > 0 ? new atomic<uint64_t>[wordCount] : nullptr);
+        rowFree.reset(rows > 0 ? new atomic<uint16_t>[rows] : nullptr);
+    }
+
+    void recountRows() {
+        for (int row = 0; row < rows; row++) {
+            int freeSeats = 0;
+            for (int seat = 0; seat < seatsPerRow; seat++) {
+                if (!isOccupied(row, seat)) {
+                    freeSeats++;
+                }
+            }
+            rowFree[row].store(static_cast<uint16_t>(freeSeats), memory_order_relaxed);
+        }
+    }
+
+public:
+    SeatMap() : rows(0), seatsPerRow(0), wordCount(0) {}
+
+    SeatMap(const SeatMap& other) : rows(0), seatsPerRow(0), wordCount(0) {
+        *this = other;
+    }
+
+    SeatMap(SeatMap&& other) noexcept
+        : rows(other.rows), seatsPerRow(other.seatsPerRow), wordCount(other.wordCount),
+          words(std::move(other.words)), rowFree(std::move(other.rowFree)) {
+        other.rows = 0;
+        other.seatsPerRow = 0;
+        other.wordCount = 0;
+    }
+
+    SeatMap& operator=(SeatMap&& other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+        
+        rows = exchange(other.rows, 0);
+        seatsPerRow = exchange(other.seatsPerRow, 0);
+        wordCount = exchange(other.wordCount, 0);
+        words = std::move(other.words);
+        rowFree = std::move(other.rowFree);
+        return *this;
+    }
+
+    SeatMap& operator=(const SeatMap& other) {
+        if (this == &other) {
+            return *this;
+        }
+        
+        allocate(other.rows, other.seatsPerRow);
+        for (size_t w = 0; w < wordCount; w++) {
+            words[w].store(other.words[w].load(memory_order_acquire), memory_order_relaxed);
+        }
+        for (int row = 0; row < rows; row++) {
+            rowFree[row].store(other.rowFree[row].load(memory_order_relaxed), memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    void reset(int rowCount, int seatsInRow) {
+        allocate(rowCount, seatsInRow);
+        
+        for (size_t w = 0; w < wordCount; w++) {
+            words[w].store(0, memory_order_relaxed);
+        }
+        for (int row = 0; row < rows; row++) {
+            rowFree[row].store(static_cast<uint16_t>(seatsPerRow), memory_order_relaxed);
+        }
+        
+        int totalBits = rows * seatsPerRow;
+        if (totalBits % 64 != 0) {
+            words[wordCount - 1].store(~0ULL << (totalBits % 64), memory_order_relaxed);
+        }
+    }
+
+    int getRows() const { return rows; }
+    int getSeatsPerRow() const { return seatsPerRow; }
+    bool empty() const { return rows == 0; }
+
+    bool isOccupied(int row, int seat) const {
+        int bit = row * seatsPerRow + seat;
+        return (words[bit / 64].load(memory_order_acquire) >> (bit % 64)) & 1ULL;
+    }
+
+    bool setOccupied(int row, int seat, bool occupied) {
+        int bit = row * seatsPerRow + seat;
+        uint64_t mask = 1ULL << (bit % 64);
+        atomic<uint64_t>& word = words[bit / 64];
+        
+        uint64_t current = word.load(memory_order_acquire);
+        uint64_t desired;
+        do {
+            if (((current & mask) != 0) == occupied) {
+                return false;
+            }
+            desired = occupied ? (current | mask) : (current & ~mask);
+        } while (!word.compare_exchange_weak(current, desired, memory_order_acq_rel, memory_order_acquire));
+        
+        if (occupied) {
+            rowFree[row].fetch_sub(1, memory_order_relaxed);
+        } else {
+            rowFree[row].fetch_add(1, memory_order_relaxed);
+        }
+        return true;
+    }
+
+    int freeInRow(int row) const {
+        return rowFree[row].load(memory_order_relaxed);
+    }
+
+    vector<uint64_t> getWords() const {
+        vector<uint64_t> snapshot(wordCount);
+        for (size_t w = 0; w < wordCount; w++) {
+            snapshot[w] = words[w].load(memory_order_acquire);
+        }
+        return snapshot;
+    }
+
+    void assignWords(int rowCount, int seatsInRow, const unsigned char* data) {
+        allocate(rowCount, seatsInRow);
+        
+        for (size_t w = 0; w < wordCount; w++) {
+            uint64_t word;
+            memcpy(&word, data + w * sizeof(uint64_t), sizeof(word));
+            words[w].store(word, memory_order_relaxed);
+        }
+        
+        recountRows();
+    }
+
+    size_t firstCandidateWord() const {
+        int row = 0;
+        while (row < rows && freeInRow(row) == 0) {
+            row++;
+        }
+        return row == rows ? wordCount : (static_cast<size_t>(row) * seatsPerRow) / 64;
+    }
+
+    int firstFreeSeat() const {
+        for (size_t w = firstCandidateWord(); w < wordCount; w++) {
+            uint64_t freeBits = ~words[w].load(memory_order_acquire);
+            if (freeBits != 0) {
+                return static_cast<int>(w * 64) + countTrailingZeros(freeBits);
+            }
+        }
+        return -1;
+    }
+
+    int claimFirstFreeSeat() {
+        for (size_t w = firstCandidateWord(); w < wordCount; w++) {
+            uint64_t current = words[w].load(memory_order_acquire);
+            while (~current != 0) {
+                int bit = countTrailingZeros(~current);
+                if (words[w].compare_exchange_weak(current, current | (1ULL << bit),
+                                                   memory_order_acq_rel, memory_order_acquire)) {
+                    int seat = static_cast<int>(w * 64) + bit;
+                    rowFree[seat / seatsPerRow].fetch_sub(1, memory_order_relaxed);
+                    return seat;
+                }
+            }
+        }
+        return -1;
+    }
+};
+
+struct SeatLayoutInfo {
+    int totalColumns;
+    int seatColumns;
+    const int8_t* columnToSeat;
+    const int8_t* letterToSeat;
+};
+
+template <int Columns, int... Aisles>
+struct SeatLayout {
+    static constexpr int totalColumns = Columns;
+    static constexpr int seatColumns = Columns - static_cast<int>(sizeof...(Aisles));
+
+    static constexpr bool isAisle(int col) {
+        return ((col == Aisles) || ...);
+    }
+
+    static constexpr array<int8_t, Columns> buildColumnToSeat() {
+        array<int8_t, Columns> table{};
+        int8_t seat = 0;
+        for (int col = 0; col < Columns; col++) {
+            table[col] = isAisle(col) ? -1 : seat++;
+        }
+        return table;
+    }
+
+    static constexpr array<int8_t, 26> buildLetterToSeat() {
+        array<int8_t, 26> table{};
+        for (int letter = 0; letter < 26; letter++) {
+            table[letter] = letter < seatColumns ? static_cast<int8_t>(letter) : -1;
+        }
+        return table;
+    }
+
+    static constexpr array<int8_t, Columns> columnToSeat = buildColumnToSeat();
+    static constexpr array<int8_t, 26> letterToSeat = buildLetterToSeat();
+    static constexpr SeatLayoutInfo info = { Columns, seatColumns, columnToSeat.data(), letterToSeat.data() };
+};
+
+using RegionalLayout = SeatLayout<5, 2>;
+using NarrowBodyLayout = SeatLayout<7, 3>;
+using WideBodyLayout = SeatLayout<11, 3, 8>;
+
+const SeatLayoutInfo& seatLayoutForCapacity(int capacity) {
+    if (capacity < 60) {
+        return RegionalLayout::info;
+    }
+    else if (capacity < 150) {
+        return NarrowBodyLayout::info;
+    }
+    return WideBodyLayout::info;
+}
+
+enum class SeatResult {
+    Ok,
+    InvalidFormat,
+    InvalidRow,
+    InvalidColumn,
+    OutOfRange,
+    Occupied,
+    AlreadyAvailable,
+    UnknownFlight
+};
+
+string seatResultMessage(SeatResult result, const string& seatNumber) {
+    switch (result) {
+        case SeatResult::Ok:
+            return "";
+        case SeatResult::InvalidFormat:
+            return "Error parsing seat number: Invalid seat number format";
+        case SeatResult::InvalidRow:
+            return "Error parsing seat number: Invalid row number in seat";
+        case SeatResult::InvalidColumn:
+            return "Error parsing seat number: Invalid column letter in seat";
+        case SeatResult::OutOfRange:
+            return "Seat number out of range";
+        case SeatResult::Occupied:
+            return "Seat " + seatNumber + " is not available";
+        case SeatResult::AlreadyAvailable:
+            return "Seat " + seatNumber + " is already available";
+        case SeatResult::UnknownFlight:
+            return "Flight not found";
+    }
+    return "";
+}
+
+enum class WaitlistResult {
+    Queued,
+    AlreadyQueued,
+    UnknownFlight
+};
+
+string waitlistResultMessage(WaitlistResult result, const string& flightID) {
+    switch (result) {
+        case WaitlistResult::Queued:
+            return "";
+        case WaitlistResult::AlreadyQueued:
+            return "Already on the waiting list for flight " + flightID;
+        case WaitlistResult::UnknownFlight:
+            return "Flight not found: " + flightID;
+    }
+    return "";
+}
+
+struct SeatPosition {
+    int row;
+    int seat;
+};
+
+class FlightRegistry {
+private:
+    static unordered_map<string, size_t, CaseInsensitiveHash, CaseInsensitiveEqual> index;
+
+public:
+    static void rebuild();
+    static Flight* find(const string& flightID);
+    static bool slotOf(const Flight& flight, size_t& slot);
+    static void add(Flight flight);
+    static bool remove(const string& flightID);
+};
+
+class FlightCatalog {
+public:
+    static constexpr int64_t unknownTime = unknownScheduleTime;
+
+    struct Query {
+        string destination;
+        string airline;
+        string status;
+        bool openOnly;
+        int64_t departingAfter;
+        int64_t departingBefore;
+
+        Query() : openOnly(false), departingAfter(INT64_MIN), departingBefore(INT64_MAX) {}
+    };
+
+private:
+    struct Dictionary {
+        vector<const string*> values;
+        unordered_map<const string*, uint32_t> codes;
+
+        uint32_t code(const string& interned);
+        vector<uint8_t> matching(const string& text) const;
+        void clear();
+    };
+
+    static vector<CopyableAtomic<int>> available;
+    static vector<int> capacities;
+    static vector<int64_t> departures;
+    static vector<uint32_t> airlineCodes;
+    static vector<uint32_t> statusCodes;
+    static Dictionary airlines;
+    static Dictionary statuses;
+
+    static void assign(size_t slot, const Flight& flight);
+
+public:
+    static void rebuild();
+    static void append(const Flight& flight);
+    static void erase(size_t slot);
+    static void refresh(const Flight& flight);
+    static void seatsChanged(const Flight& flight);
+    static vector<Flight*> select(const Query& query);
+};
+
+class ScheduleIndex {
+private:
+    static vector<pair<int64_t, string>> entries;
+
+    static vector<pair<int64_t, string>>::iterator locate(int64_t departure, const string& flightID);
+
+public:
+    static void rebuild();
+    static void add(const Flight& flight);
+    static void remove(const Flight& flight);
+    static void reschedule(const Flight& flight, int64_t previousDeparture);
+    static vector<Flight*> departingBetween(int64_t from, int64_t to);
+    static vector<Flight*> departedBefore(int64_t cutoff) { return departingBetween(unknownScheduleTime, cutoff); }
+};
+
+class SeatMapCache {
+private:
+    static constexpr size_t maxResident = 256;
+
+    static list<string> order;
+    static unordered_map<string, list<string>::iterator, CaseInsensitiveHash, CaseInsensitiveEqual> entries;
+    static mutex cacheMutex;
+
+    static void evictIfNeeded();
+
+public:
+    static void touch(const string& flightID);
+    static void forget(const string& flightID);
+    static void clear();
+};
+
+class Reservation;
+class WaitingList;
+
+class BookingService {
+private:
+    static shared_mutex catalogMutex;
+    static mutex locksMutex;
+    static mutex storeMutex;
+    static unordered_map<string, unique_ptr<shared_mutex>, CaseInsensitiveHash, CaseInsensitiveEqual> flightLocks;
+
+    static shared_mutex& flightLock(const string& flightID);
+    static shared_lock<shared_mutex> lockResident(const Flight& flight);
+    static void recordBooking(const Flight& flight, const string& seatNumber, const string& username,
+                              const string& passengerName, const string& paymentDetails, Reservation& booked);
+    static bool release(const string& reservationID, const string& username, bool requireOwner);
+
+public:
+    static shared_mutex& catalog() { return catalogMutex; }
+    static unique_lock<shared_mutex> tryLockFlight(const string& flightID);
+    static void forget(const string& flightID);
+
+    static SeatResult book(const string& flightID, const string& seatNumber, const string& username,
+                           const string& passengerName, const string& paymentDetails, Reservation& booked);
+    static SeatResult bookFirstAvailable(const string& flightID, const string& username,
+                                         const string& passengerName, const string& paymentDetails, Reservation& booked);
+    static bool cancel(const string& username, const string& reservationID);
+    static bool removeReservation(const string& reservationID);
+    static size_t unlinkFlight(const string& flightID);
+    static size_t unlinkUser(const string& username);
+    static bool deleteFlight(const string& flightID);
+    static bool deleteUser(const string& username);
+    static bool promoteWaitlisted(const string& flightID, const string& seatNumber);
+    static WaitlistResult joinWaitingList(const string& flightID, const string& username, const string& passengerName);
+    static bool leaveWaitingList(const string& flightID, const string& username);
+    static WaitingList waitingListFor(const string& flightID);
+    static bool updateFlight(const string& flightID, const string& airlineName, int64_t departureAt,
+                             int64_t arrivalAt, const string& status);
+    static bool inspectFlight(const string& flightID, const function<void(const Flight&)>& visit);
+    static vector<Reservation> reservationsFor(const string& username);
+    static vector<Reservation> reservationsForFlight(const string& flightID);
+    static vector<Reservation> archivedReservationsFor(const string& username);
+    static vector<string> archiveDeparted();
+    static bool seatMapFor(const string& flightID, vector<string>& rows, int& availableSeats);
+    static void compactIfDue();
+};
+
+class Flight {
+private:
+    string flightID;
+    InternedString airlineName;
+    string planeID;
+    int capacity;
+    CopyableAtomic<int> availableSeats;
+    InternedString destination;
+    int64_t departureAt;
+    int64_t arrivalAt;
+    InternedString status;
+    mutable SeatMap seatMap;
+    mutable CopyableAtomic<bool> seatMapLoaded;
+    mutable CopyableAtomic<bool> seatMapDirty;
+    const SeatLayoutInfo* layout;
+    mutable const unsigned char* snapshotSeats;
+    int snapshotSeatRows;
+
+    static constexpr char packedSeatMapTag = 'B';
+
+    friend class Snapshot;
+
+    void resetSeatMap() const {
+        int seatsInRow = layout->seatColumns;
+        int totalRows = (capacity + seatsInRow - 1) / seatsInRow;
+        
+        seatMap.reset(totalRows, seatsInRow);
+        
+        for (int seat = capacity; seat < totalRows * seatsInRow; seat++) {
+            seatMap.setOccupied(seat / seatsInRow, seat % seatsInRow, true);
+        }
+        
+        seatMapLoaded = true;
+        seatMapDirty = true;
+    }
+
+    void ensureSeatMap() const {
+        if (!seatMapLoaded && snapshotSeats != nullptr) {
+            seatMap.assignWords(snapshotSeatRows, layout->seatColumns, snapshotSeats);
+            seatMapLoaded = true;
+            seatMapDirty = false;
+        } else if (!seatMapLoaded) {
+            string payload;
+            SegmentStore::seatMaps().get(flightID, payload);
+            if (!unpackSeatMap(payload)) {
+                loadSeatMap(payload);
+            }
+        }
+        SeatMapCache::touch(flightID);
+    }
+
+public:
+    Flight() : departureAt(unknownScheduleTime), arrivalAt(unknownScheduleTime),
+               seatMapLoaded(false), seatMapDirty(false), layout(&NarrowBodyLayout::info),
+               snapshotSeats(nullptr), snapshotSeatRows(0) {}
+
+    Flight(const string& airlineName, const string& planeID, int capacity, 
+           const string& destination, int64_t departureAt, int64_t arrivalAt) 
+        : airlineName(airlineName), planeID(planeID), capacity(capacity), 
+          availableSeats(capacity), destination(destination), 
+          departureAt(departureAt), arrivalAt(arrivalAt), status("On Time"),
+          seatMapLoaded(false), seatMapDirty(false), snapshotSeats(nullptr), snapshotSeatRows(0) {
+        
+        flightID = generateID("FL");
+        
+        calculateSeatLayout();
+        
+        initializeSeatMap();
+    }
+
+    Flight(const Flight&) = default;
+    Flight(Flight&&) noexcept = default;
+    Flight& operator=(const Flight&) = default;
+    Flight& operator=(Flight&&) noexcept = default;
+
+    void calculateSeatLayout() {
+        layout = &seatLayoutForCapacity(capacity);
+    }
+
+    void initializeSeatMap() {
+        resetSeatMap();
+    }
+
+    bool isSeatMapResident() const {
+        return seatMapLoaded;
+    }
+
+    void prepareSeatMap() const {
+        ensureSeatMap();
+    }
+
+    bool releaseSeatMap() {
+        if (!seatMapLoaded || seatMapDirty) {
+            return false;
+        }
+        
+        seatMap = SeatMap();
+        seatMapLoaded = false;
+        return true;
+    }
+
+    const string& getFlightID() const { return flightID; }
+    const string& getAirlineName() const { return airlineName; }
+    const string& getPlaneID() const { return planeID; }
+    int getCapacity() const { return capacity; }
+    int getAvailableSeats() const { return availableSeats; }
+    const string& getDestination() const { return destination; }
+    const string& getDepartureTime() const { return ScheduleClock::format(departureAt); }
+    const string& getArrivalTime() const { return ScheduleClock::format(arrivalAt); }
+    int64_t getDepartureAt() const { return departureAt; }
+    int64_t getArrivalAt() const { return arrivalAt; }
+    const string& getStatus() const { return status; }
+
+    void setAirlineName(const string& name) { airlineName = name; FlightCatalog::refresh(*this); }
+    void setPlaneID(const string& id) { planeID = id; }
+    void setCapacity(int cap) { 
+        capacity = cap; 
+        calculateSeatLayout();
+        snapshotSeats = nullptr;
+        initializeSeatMap();
+        FlightCatalog::refresh(*this);
+    }
+    void setDestination(const string& dest) { destination = dest; FlightCatalog::refresh(*this); }
+    void setDepartureAt(int64_t time) {
+        int64_t previous = departureAt;
+        departureAt = time;
+        ScheduleIndex::reschedule(*this, previous);
+        FlightCatalog::refresh(*this);
+    }
+    void setArrivalAt(int64_t time) { arrivalAt = time; }
+    bool setDepartureTime(const string& time) {
+        int64_t parsed;
+        if (!parseScheduleTime(time, parsed)) {
+            return false;
+        }
+        setDepartureAt(parsed);
+        return true;
+    }
+    bool setArrivalTime(const string& time) {
+        return parseScheduleTime(time, arrivalAt);
+    }
+    void setStatus(const string& stat) { status = stat; FlightCatalog::refresh(*this); }
+
+    int seatRows() const noexcept {
+        return (capacity + layout->seatColumns - 1) / layout->seatColumns;
+    }
+
+    bool holdsSeat(const SeatPosition& position) const noexcept {
+        return seatMapLoaded && position.row < seatMap.getRows();
+    }
+
+    SeatResult tryParseSeat(const string& seatNumber, SeatPosition& position) const noexcept {
+        size_t length = seatNumber.length();
+        if (length < 2) {
+            return SeatResult::InvalidFormat;
+        }
+        
+        unsigned char colLetter = toupper(static_cast<unsigned char>(seatNumber[length - 1]));
+        if (colLetter < 'A' || colLetter > 'Z') {
+            return SeatResult::InvalidColumn;
+        }
+        
+        if (length - 1 > 9) {
+            return SeatResult::OutOfRange;
+        }
+        
+        int row = 0;
+        for (size_t i = 0; i + 1 < length; i++) {
+            unsigned char c = seatNumber[i];
+            if (!isdigit(c)) {
+                return SeatResult::InvalidRow;
+            }
+            row = row * 10 + (c - '0');
+        }
+        
+        position.row = row - 1;
+        position.seat = layout->letterToSeat[colLetter - 'A'];
+        
+        if (position.row < 0 || position.row >= seatRows() || position.seat < 0) {
+            return SeatResult::OutOfRange;
+        }
+        return SeatResult::Ok;
+    }
+
+    SeatResult checkSeat(const string& seatNumber) const noexcept {
+        SeatPosition position;
+        SeatResult result = tryParseSeat(seatNumber, position);
+        if (result != SeatResult::Ok) {
+            return result;
+        }
+        if (!holdsSeat(position)) {
+            return SeatResult::OutOfRange;
+        }
+        return seatMap.isOccupied(position.row, position.seat) ? SeatResult::Occupied : SeatResult::Ok;
+    }
+
+    SeatResult tryBook(const string& seatNumber) noexcept {
+        SeatPosition position;
+        SeatResult result = tryParseSeat(seatNumber, position);
+        if (result != SeatResult::Ok) {
+            return result;
+        }
+        if (!holdsSeat(position)) {
+            return SeatResult::OutOfRange;
+        }
+        
+        if (!seatMap.setOccupied(position.row, position.seat, true)) {
+            return SeatResult::Occupied;
+        }
+        
+        seatMapDirty = true;
+        availableSeats.fetchSub(1);
+        FlightCatalog::seatsChanged(*this);
+        return SeatResult::Ok;
+    }
+
+    SeatResult tryBookFirstAvailable(string& seatNumber) noexcept {
+        int seat = seatMap.claimFirstFreeSeat();
+        if (seat < 0) {
+            return SeatResult::Occupied;
+        }
+        
+        seatMapDirty = true;
+        availableSeats.fetchSub(1);
+        FlightCatalog::seatsChanged(*this);
+        seatNumber = indicesToSeatNumber(seat / seatMap.getSeatsPerRow(), seat % seatMap.getSeatsPerRow());
+        return SeatResult::Ok;
+    }
+
+    SeatResult tryCancel(const string& seatNumber) noexcept {
+        SeatPosition position;
+        SeatResult result = tryParseSeat(seatNumber, position);
+        if (result != SeatResult::Ok) {
+            return result;
+        }
+        if (!holdsSeat(position)) {
+            return SeatResult::OutOfRange;
+        }
+        
+        if (!seatMap.setOccupied(position.row, position.seat, false)) {
+            return SeatResult::AlreadyAvailable;
+        }
+        
+        seatMapDirty = true;
+        availableSeats.fetchAdd(1);
+        FlightCatalog::seatsChanged(*this);
+        return SeatResult::Ok;
+    }
+
+    string indicesToSeatNumber(int row, int seat) const {
+        char colLetter = 'A' + seat;
+        return to_string(row + 1) + colLetter;
+    }
+
+    bool isSeatAvailable(const string& seatNumber) const {
+        ensureSeatMap();
+        SeatResult result = checkSeat(seatNumber);
+        if (result != SeatResult::Ok && result != SeatResult::Occupied) {
+            printErrorMessage("Error checking seat availability: " + seatResultMessage(result, seatNumber));
+        }
+        return result == SeatResult::Ok;
+    }
+
+    bool bookSeat(const string& seatNumber) {
+        ensureSeatMap();
+        SeatResult result = tryBook(seatNumber);
+        if (result != SeatResult::Ok) {
+            printErrorMessage("Error booking seat: " + seatResultMessage(result, seatNumber));
+        }
+        return result == SeatResult::Ok;
+    }
+
+    bool cancelSeat(const string& seatNumber) {
+        ensureSeatMap();
+        SeatResult result = tryCancel(seatNumber);
+        if (result != SeatResult::Ok) {
+            printErrorMessage("Error canceling seat: " + seatResultMessage(result, seatNumber));
+        }
+        return result == SeatResult::Ok;
+    }
+
+    bool setSeatOccupied(const string& seatNumber, bool occupied) {
+        ensureSeatMap();
+        SeatResult result = occupied ? tryBook(seatNumber) : tryCancel(seatNumber);
+        return result == SeatResult::Ok;
+    }
+
+    void displaySeatMap() const {
+        printSubHeader("Seat Map for Flight " + flightID + " (" + airlineName.str() + ")");
+        
+        cout << "  Destination: " << destination.str() << "\n";
+        cout << "  Available Seats: " << availableSeats << " out of " << capacity << "\n\n";
+        
+        ensureSeatMap();
+        
+        string screen;
+        screen.reserve((seatMap.getRows() + 4) * (layout->totalColumns * 4 + 8));
+        
+        screen += "    ";
+        for (int j = 0; j < layout->totalColumns; j++) {
+            int seat = layout->columnToSeat[j];
+            if (seat < 0) {
+                screen += "    ";
+            } else {
+                screen += static_cast<char>('A' + seat);
+                screen += "   ";
+            }
+        }
+        screen += '\n';
+        
+        for (int i = 0; i < seatMap.getRows(); i++) {
+            string rowNumber = to_string(i + 1);
+            if (rowNumber.size() < 2) {
+                screen += ' ';
+            }
+            screen += rowNumber;
+            screen += "  ";
+            
+            for (int j = 0; j < layout->totalColumns; j++) {
+                int seat = layout->columnToSeat[j];
+                if (seat < 0) {
+                    screen += "|   ";
+                } else {
+                    screen += seatMap.isOccupied(i, seat) ? "X   " : "O   ";
+                }
+            }
+            screen += '\n';
+        }
+        
+        screen += "\n  O - Available  X - Occupied  | - Aisle\n";
+        cout.write(screen.data(), screen.size());
+    }
+
+    vector<string> getSeatMapRows() const {
+        ensureSeatMap();
+        
+        vector<string> rows;
+        rows.reserve(seatMap.getRows());
+        for (int i = 0; i < seatMap.getRows(); i++) {
+            string row;
+            for (int j = 0; j < layout->totalColumns; j++) {
+                int seat = layout->columnToSeat[j];
+                if (seat < 0) {
+                    row += '|';
+                } else {
+                    row += seatMap.isOccupied(i, seat) ? 'X' : 'O';
+                }
+            }
+            rows.push_back(row);
+        }
+        return rows;
+    }
+
+    string getFirstAvailableSeat() const {
+        ensureSeatMap();
+        
+        int seat = seatMap.firstFreeSeat();
+        if (seat < 0) {
+            return "";
+        }
+        return indicesToSeatNumber(seat / seatMap.getSeatsPerRow(), seat % seatMap.getSeatsPerRow());
+    }
+
+    bool isFullyBooked() const {
+        return availableSeats == 0;
+    }
+
+    string toRecord() const {
+        stringstream ss;
+        ss << flightID << ","
+           << quoteField(airlineName) << ","
+           << quoteField(planeID) << ","
+           << capacity << ","
+           << availableSeats << ","
+           << quoteField(destination) << ","
+           << quoteField(getDepartureTime()) << ","
+           << quoteField(getArrivalTime()) << ","
+           << quoteField(status);
+        return ss.str();
+    }
+
+    void saveToFile() const {
+        try {
+            DatabaseManager::getInstance()->saveData("flights.txt", toRecord());
+            saveSeatMap();
+            SegmentStore::seatMaps().flush();
+        } catch (const exception& e) {
+            printErrorMessage("Error saving flight: " + string(e.what()));
+        }
+    }
+
+    void saveSeatMap() const {
+        if (!seatMapLoaded || !seatMapDirty) {
+            return;
+        }
+        
+        try {
+            if (SegmentStore::seatMaps().put(flightID, packedSeatMap())) {
+                seatMapDirty = false;
+                snapshotSeats = nullptr;
+            }
+        } catch (const exception& e) {
+            printErrorMessage("Error saving seat map: " + string(e.what()));
+        }
+    }
+
+    string packedSeatMap() const {
+        vector<uint64_t> words = seatMap.getWords();
+        int32_t rows = seatMap.getRows();
+        
+        string payload(1, packedSeatMapTag);
+        payload.append(reinterpret_cast<const char*>(&rows), sizeof(rows));
+        payload.append(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint64_t));
+        return payload;
+    }
+
+    bool unpackSeatMap(const string& payload) const {
+        int32_t rows = 0;
+        if (payload.size() < 1 + sizeof(rows) || payload[0] != packedSeatMapTag) {
+            return false;
+        }
+        
+        memcpy(&rows, payload.data() + 1, sizeof(rows));
+        size_t wordBytes = ((static_cast<size_t>(rows) * layout->seatColumns + 63) / 64) * sizeof(uint64_t);
+        if (rows <= 0 || payload.size() != 1 + sizeof(rows) + wordBytes) {
+            return false;
+        }
+        
+        seatMap.assignWords(rows, layout->seatColumns,
+                            reinterpret_cast<const unsigned char*>(payload.data()) + 1 + sizeof(rows));
+        seatMapLoaded = true;
+        seatMapDirty = false;
+        return true;
+    }
+
+    static bool isSeatRow(const CsvRecord& record) {
+        for (const auto& field : record.getFields()) {
+            if (field.find_first_of("01") != string_view::npos) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void loadSeatMap(const string& seatData) const {
+        CsvRecord record;
+        int rowCount = 0;
+        
+        CsvReader counter(seatData);
+        while (counter.next(record)) {
+            if (isSeatRow(record)) {
+                rowCount++;
+            }
+        }
+        
+        if (rowCount == 0) {
+            resetSeatMap();
+            return;
+        }
+        
+        seatMap.reset(rowCount, layout->seatColumns);
+        seatMapLoaded = true;
+        seatMapDirty = false;
+        
+        CsvReader reader(seatData);
+        int row = 0;
+        while (reader.next(record)) {
+            if (!isSeatRow(record)) {
+                continue;
+            }
+            
+            for (int j = 0; j < layout->totalColumns; j++) {
+                int seat = layout->columnToSeat[j];
+                if (seat < 0) {
+                    continue;
+                }
+                
+                bool occupied = j >= static_cast<int>(record.size()) || record[j] != "0";
+                seatMap.setOccupied(row, seat, occupied);
+            }
+            row++;
+        }
+    }
+
+    static bool fromTokens(const vector<string_view>& fields, Flight& flight) {
+        if (fields.size() < 9) {
+            return false;
+        }
+        
+        int capacity;
+        int availableSeats;
+        if (!parseInt(fields[3], capacity) || !parseInt(fields[4], availableSeats)) {
+            return false;
+        }
+        
+        flight.flightID = string(fields[0]);
+        flight.airlineName = string(fields[1]);
+        flight.planeID = string(fields[2]);
+        flight.capacity = capacity;
+        flight.availableSeats = availableSeats;
+        flight.destination = string(fields[5]);
+        
+        if (!parseScheduleTime(fields[6], flight.departureAt)) {
+            flight.departureAt = unknownScheduleTime;
+        }
+        
+        if (!parseScheduleTime(fields[7], flight.arrivalAt)) {
+            flight.arrivalAt = unknownScheduleTime;
+        }
+        
+        flight.status = string(fields[8]);
+        
+        flight.calculateSeatLayout();
+        return true;
+    }
+
+    static vector<Flight> readFlights(vector<string>& rejected) {
+        size_t chunkCount = WorkerPool::concurrency();
+        vector<vector<Flight>> parsed(chunkCount);
+        vector<vector<string>> invalid(chunkCount);
+        
+        DatabaseManager* dbManager = DatabaseManager::getInstance();
+        dbManager->forEachRecordParallel("flights.txt", chunkCount, [&](size_t chunk, const CsvRecord& record) {
+            Flight flight;
+            if (!fromTokens(record.getFields(), flight)) {
+                invalid[chunk].push_back(record.str(0));
+                return;
+            }
+            
+            parsed[chunk].push_back(std::move(flight));
+        }, [&](size_t chunk, size_t lines) { parsed[chunk].reserve(lines); });
+        
+        for (const auto& lines : invalid) {
+            rejected.insert(rejected.end(), lines.begin(), lines.end());
+        }
+        return concatenateChunks(parsed);
+    }
+
+    static void publishFlights(vector<Flight>& loaded, const vector<string>& rejected) {
+        for (const auto& flightID : rejected) {
+            printErrorMessage("Invalid flight data format: " + flightID);
+        }
+        for (const auto& flight : loaded) {
+            if (flight.departureAt == unknownScheduleTime || flight.arrivalAt == unknownScheduleTime) {
+                printWarningMessage("Flight " + flight.flightID + " has an unreadable schedule; its times are left unknown");
+            }
+        }
+        
+        flights.swap(loaded);
+        SeatMapCache::clear();
+        FlightRegistry::rebuild();
+    }
+
+    static void loadFlights() {
+        try {
+            vector<string> rejected;
+            vector<Flight> loaded = readFlights(rejected);
+            publishFlights(loaded, rejected);
+        } catch (const exception& e) {
+            printErrorMessage("Error loading flights: " + string(e.what()));
+        }
+    }
+
+    static void saveSeatMaps() {
+        try {
+            for (const auto& flight : flights) {
+                flight.saveSeatMap();
+            }
+            SegmentStore::seatMaps().flush();
+        } catch (const exception& e) {
+            printErrorMessage("Error saving seat maps: " + string(e.what()));
+        }
+    }
+
+    static void saveAllFlights() {
+        try {
+            DatabaseManager* dbManager = DatabaseManager::getInstance();
+            dbManager->beginBatch("flights.txt");
+            
+            for (const auto& flight : flights) {
+                dbManager->appendToBatch("flights.txt", flight.toRecord());
+                flight.saveSeatMap();
+            }
+            
+            SegmentStore::seatMaps().flush();
+            dbManager->commitBatch("flights.txt");
+        } catch (const exception& e) {
+            printErrorMessage("Error saving all flights: " + string(e.what()));
+        }
+    }
+};
+
+unordered_map<string, size_t, CaseInsensitiveHash, CaseInsensitiveEqual> FlightRegistry::index;
+
+void FlightRegistry::rebuild() {
+    index.clear();
+    index.reserve(flights.size());
+    
+    for (size_t i = 0; i < flights.size(); i++) {
+        index[flights[i].getFlightID()] = i;
+    }
+    FlightCatalog::rebuild();
+    ScheduleIndex::rebuild();
+}
+
+Flight* FlightRegistry::find(const string& flightID) {
+    auto it = index.find(flightID);
+    if (it == index.end()) {
+        return nullptr;
+    }
+    return &flights[it->second];
+}
+
+bool FlightRegistry::slotOf(const Flight& flight, size_t& slot) {
+    auto it = index.find(flight.getFlightID());
+    if (it == index.end() || &flights[it->second] != &flight) {
+        return false;
+    }
+    slot = it->second;
+    return true;
+}
+
+void FlightRegistry::add(Flight flight) {
+    flights.push_back(std::move(flight));
+    index[flights.back().getFlightID()] = flights.size() - 1;
+    FlightCatalog::append(flights.back());
+    ScheduleIndex::add(flights.back());
+}
+
+bool FlightRegistry::remove(const string& flightID) {
+    auto it = index.find(flightID);
+    if (it == index.end()) {
+        return false;
+    }
+    
+    size_t slot = it->second;
+    index.erase(it);
+    ScheduleIndex::remove(flights[slot]);
+    SeatMapCache::forget(flightID);
+    BookingService::forget(flightID);
+    
+    size_t last = flights.size() - 1;
+    if (slot != last) {
+        flights[slot] = std::move(flights[last]);
+        index[flights[slot].getFlightID()] = slot;
+    }
+    flights.pop_back();
+    FlightCatalog::erase(slot);
+    return true;
+}
+
+vector<CopyableAtomic<int>> FlightCatalog::available;
+vector<int> FlightCatalog::capacities;
+vector<int64_t> FlightCatalog::departures;
+vector<uint32_t> FlightCatalog::airlineCodes;
+vector<uint32_t> FlightCatalog::statusCodes;
+FlightCatalog::Dictionary FlightCatalog::airlines;
+FlightCatalog::Dictionary FlightCatalog::statuses;
+
+uint32_t FlightCatalog::Dictionary::code(const string& interned) {
+    auto it = codes.find(&interned);
+    if (it != codes.end()) {
+        return it->second;
+    }
+    
+    uint32_t assigned = static_cast<uint32_t>(values.size());
+    values.push_back(&interned);
+    codes.emplace(&interned, assigned);
+    return assigned;
+}
+
+vector<uint8_t> FlightCatalog::Dictionary::matching(const string& text) const {
+    vector<uint8_t> result(values.size(), 0);
+    for (size_t i = 0; i < values.size(); i++) {
+        result[i] = equalsIgnoreCase(*values[i], text) ? 1 : 0;
+    }
+    return result;
+}
+
+void FlightCatalog::Dictionary::clear() {
+    values.clear();
+    codes.clear();
+}
+
+void FlightCatalog::assign(size_t slot, const Flight& flight) {
+    available[slot] = flight.getAvailableSeats();
+    capacities[slot] = flight.getCapacity();
+    departures[slot] = flight.getDepartureAt();
+    airlineCodes[slot] = airlines.code(flight.getAirlineName());
+    statusCodes[slot] = statuses.code(flight.getStatus());
+}
+
+void FlightCatalog::rebuild() {
+    airlines.clear();
+    statuses.clear();
+    
+    size_t count = flights.size();
+    available.assign(count, CopyableAtomic<int>(0));
+    capacities.assign(count, 0);
+    departures.assign(count, unknownTime);
+    airlineCodes.assign(count, 0);
+    statusCodes.assign(count, 0);
+    
+    for (size_t i = 0; i < count; i++) {
+        assign(i, flights[i]);
+    }
+}
+
+void FlightCatalog::append(const Flight& flight) {
+    available.emplace_back(0);
+    capacities.push_back(0);
+    departures.push_back(unknownTime);
+    airlineCodes.push_back(0);
+    statusCodes.push_back(0);
+    assign(available.size() - 1, flight);
+}
+
+void FlightCatalog::erase(size_t slot) {
+    size_t last = available.size() - 1;
+    if (slot != last) {
+        available[slot] = available[last];
+        capacities[slot] = capacities[last];
+        departures[slot] = departures[last];
+        airlineCodes[slot] = airlineCodes[last];
+        statusCodes[slot] = statusCodes[last];
+    }
+    
+    available.pop_back();
+    capacities.pop_back();
+    departures.pop_back();
+    airlineCodes.pop_back();
+    statusCodes.pop_back();
+}
+
+void FlightCatalog::refresh(const Flight& flight) {
+    size_t slot;
+    if (FlightRegistry::slotOf(flight, slot)) {
+        assign(slot, flight);
+    }
+}
+
+void FlightCatalog::seatsChanged(const Flight& flight) {
+    size_t slot;
+    if (FlightRegistry::slotOf(flight, slot)) {
+        available[slot] = flight.getAvailableSeats();
+    }
+}
+
+vector<pair<int64_t, string>> ScheduleIndex::entries;
+
+vector<pair<int64_t, string>>::iterator ScheduleIndex::locate(int64_t departure, const string& flightID) {
+    auto it = lower_bound(entries.begin(), entries.end(), make_pair(departure, flightID));
+    if (it == entries.end() || it->first != departure || it->second != flightID) {
+        return entries.end();
+    }
+    return it;
+}
+
+void ScheduleIndex::rebuild() {
+    entries.clear();
+    entries.reserve(flights.size());
+    for (const auto& flight : flights) {
+        entries.emplace_back(flight.getDepartureAt(), flight.getFlightID());
+    }
+    sort(entries.begin(), entries.end());
+}
+
+void ScheduleIndex::add(const Flight& flight) {
+    auto entry = make_pair(flight.getDepartureAt(), flight.getFlightID());
+    entries.insert(upper_bound(entries.begin(), entries.end(), entry), entry);
+}
+
+void ScheduleIndex::remove(const Flight& flight) {
+    auto it = locate(flight.getDepartureAt(), flight.getFlightID());
+    if (it != entries.end()) {
+        entries.erase(it);
+    }
+}
+
+void ScheduleIndex::reschedule(const Flight& flight, int64_t previousDeparture) {
+    size_t slot;
+    if (!FlightRegistry::slotOf(flight, slot)) {
+        return;
+    }
+    
+    auto it = locate(previousDeparture, flight.getFlightID());
+    if (it != entries.end()) {
+        entries.erase(it);
+    }
+    add(flight);
+}
+
+vector<Flight*> ScheduleIndex::departingBetween(int64_t from, int64_t to) {
+    METRIC_SPAN("search_schedule");
+    vector<Flight*> results;
+    auto first = lower_bound(entries.begin(), entries.end(), make_pair(from, string()));
+    for (auto it = first; it != entries.end() && it->first < to; ++it) {
+        Flight* flight = FlightRegistry::find(it->second);
+        if (flight != nullptr) {
+            results.push_back(flight);
+        }
+    }
+    return results;
+}
+
+list<string> SeatMapCache::order;
+unordered_map<string, list<string>::iterator, CaseInsensitiveHash, CaseInsensitiveEqual> SeatMapCache::entries;
+mutex SeatMapCache::cacheMutex;
+
+void SeatMapCache::touch(const string& flightID) {
+    lock_guard<mutex> guard(cacheMutex);
+    auto it = entries.find(flightID);
+    if (it != entries.end()) {
+        order.splice(order.begin(), order, it->second);
+        return;
+    }
+    
+    order.push_front(flightID);
+    entries[flightID] = order.begin();
+    evictIfNeeded();
+}
+
+void SeatMapCache::evictIfNeeded() {
+    auto it = order.end();
+    while (entries.size() > maxResident && it != order.begin()) {
+        --it;
+        if (it == order.begin()) {
+            break;
+        }
+        
+        unique_lock<shared_mutex> flightGuard = BookingService::tryLockFlight(*it);
+        if (!flightGuard.owns_lock()) {
+            continue;
+        }
+        
+        Flight* flight = FlightRegistry::find(*it);
+        if (flight == nullptr || flight->releaseSeatMap()) {
+            entries.erase(*it);
+            it = order.erase(it);
+        }
+    }
+}
+
+void SeatMapCache::forget(const string& flightID) {
+    lock_guard<mutex> guard(cacheMutex);
+    auto it = entries.find(flightID);
+    if (it != entries.end()) {
+        order.erase(it->second);
+        entries.erase(it);
+    }
+}
+
+void SeatMapCache::clear() {
+    lock_guard<mutex> guard(cacheMutex);
+    order.clear();
+    entries.clear();
+}
+
+class DestinationIndex {
+private:
+    static constexpr size_t maxGramLength = 3;
+
+    static unordered_map<string, string, CaseInsensitiveHash, CaseInsensitiveEqual> searchKeys;
+    static unordered_map<string, unordered_set<string>> grams;
+
+    static string searchKeyFor(const string& destination) {
+        string key = toLower(destination);
+        size_t toPos = key.find(" to ");
+        if (toPos != string::npos) {
+            key = key.substr(toPos + 4);
+        }
+        return key;
+    }
+
+    static void forEachGram(const string& key, size_t length, const function<void(const string&)>& visit) {
+        for (size_t i = 0; i + length <= key.length(); i++) {
+            visit(key.substr(i, length));
+        }
+    }
+
+public:
+    static void build() {
+        searchKeys.clear();
+        grams.clear();
+        
+        for (const auto& flight : flights) {
+            add(flight);
+        }
+    }
+
+    static void add(const Flight& flight) {
+        string key = searchKeyFor(flight.getDestination());
+        const string& flightID = flight.getFlightID();
+        
+        searchKeys[flightID] = key;
+        for (size_t length = 1; length <= maxGramLength; length++) {
+            forEachGram(key, length, [&flightID](const string& gram) {
+                grams[gram].insert(flightID);
+            });
+        }
+    }
+
+    static void remove(const string& flightID) {
+        auto keyIt = searchKeys.find(flightID);
+        if (keyIt == searchKeys.end()) {
+            return;
+        }
+        
+        string storedID = keyIt->first;
+        for (size_t length = 1; length <= maxGramLength; length++) {
+            forEachGram(keyIt->second, length, [&storedID](const string& gram) {
+                auto gramIt = grams.find(gram);
+                if (gramIt != grams.end()) {
+                    gramIt->second.erase(storedID);
+                    if (gramIt->second.empty()) {
+                        grams.erase(gramIt);
+                    }
+                }
+            });
+        }
+        
+        searchKeys.erase(keyIt);
+    }
+
+    static vector<Flight*> search(const string& query) {
+        METRIC_SPAN("search_destination");
+        vector<Flight*> results;
+        string needle = toLower(query);
+        
+        if (needle.empty()) {
+            return results;
+        }
+        
+        const unordered_set<string>* candidates = nullptr;
+        size_t gramLength = min(needle.length(), maxGramLength);
+        
+        for (size_t i = 0; i + gramLength <= needle.length(); i++) {
+            auto gramIt = grams.find(needle.substr(i, gramLength));
+            if (gramIt == grams.end()) {
+                return results;
+            }
+            if (candidates == nullptr || gramIt->second.size() < candidates->size()) {
+                candidates = &gramIt->second;
+            }
+        }
+        
+        for (const auto& flightID : *candidates) {
+            auto keyIt = searchKeys.find(flightID);
+            if (keyIt == searchKeys.end()) {
+                continue;
+            }
+            if (needle.length() > maxGramLength && keyIt->second.find(needle) == string::npos) {
+                continue;
+            }
+            
+            Flight* flight = FlightRegistry::find(flightID);
+            if (flight != nullptr) {
+                results.push_back(flight);
+            }
+        }
+        
+        sort(results.begin(), results.end());
+        return results;
+    }
+};
+
+unordered_map<string, string, CaseInsensitiveHash, CaseInsensitiveEqual> DestinationIndex::searchKeys;
+unordered_map<string, unordered_set<string>> DestinationIndex::grams;
+
+vector<Flight*> FlightCatalog::select(const Query& query) {
+    METRIC_SPAN("search_catalog");
+    size_t count = available.size();
+    vector<uint8_t> keep(count);
+    
+    const int64_t* departure = departures.data();
+    for (size_t i = 0; i < count; i++) {
+        keep[i] = (departure[i] >= query.departingAfter) & (departure[i] < query.departingBefore);
+    }
+    
+    if (query.openOnly) {
+        for (size_t i = 0; i < count; i++) {
+            keep[i] &= available[i].load() > 0;
+        }
+    }
+    
+    auto applyDictionary = [&](const string& text, const Dictionary& dictionary, const vector<uint32_t>& codes) {
+        if (text.empty()) {
+            return;
+        }
+        
+        vector<uint8_t> matches = dictionary.matching(text);
+        const uint32_t* code = codes.data();
+        for (size_t i = 0; i < count; i++) {
+            keep[i] &= matches[code[i]];
+        }
+    };
+    
+    if (!query.destination.empty()) {
+        vector<uint8_t> matches(count, 0);
+        for (const Flight* flight : DestinationIndex::search(query.destination)) {
+            matches[flight - flights.data()] = 1;
+        }
+        for (size_t i = 0; i < count; i++) {
+            keep[i] &= matches[i];
+        }
+    }
+    
+    applyDictionary(query.airline, airlines, airlineCodes);
+    applyDictionary(query.status, statuses, statusCodes);
+    
+    vector<Flight*> results;
+    for (size_t i = 0; i < count; i++) {
+        if (keep[i]) {
+            results.push_back(&flights[i]);
+        }
+    }
+    return results;
+}
+
+class ReservationStore {
+private:
+    static unordered_map<string, size_t, CaseInsensitiveHash, CaseInsensitiveEqual> slots;
+    static unordered_map<string, vector<string>> byUser;
+    static unordered_map<string, vector<string>, CaseInsensitiveHash, CaseInsensitiveEqual> byFlight;
+
+    template <typename Index>
+    static void unlink(Index& index, const string& key, const string& reservationID);
+
+public:
+    static void rebuild();
+    static Reservation* find(const string& reservationID);
+    static vector<Reservation> forUser(const string& username);
+    static vector<string> idsForFlight(const string& flightID);
+    static vector<Reservation> forFlight(const string& flightID);
+    static void add(const Reservation& reservation);
+    static bool remove(const string& reservationID);
+    static size_t removeForFlight(const string& flightID);
+    static size_t removeForUser(const string& username);
+};
+
+class Reservation {
+private:
+    string reservationID;
+    string passengerName;
+    string flightID;
+    InternedString airlineName;
+    InternedString destination;
+    string seatNumber;
+    InternedString status;
+    string username;
+    InternedString paymentMethod;
+
+public:
+    Reservation() {}
+
+    Reservation(const string& passengerName, const string& flightID, 
+                const string& airlineName, const string& destination, 
+                const string& seatNumber, const string& username,
+                const string& paymentMethod = "")
+        : passengerName(passengerName), flightID(flightID), 
+          airlineName(airlineName), destination(destination), 
+          seatNumber(seatNumber), status("Confirmed"), username(username),
+          paymentMethod(paymentMethod) {
+        
+        reservationID = generateID("RES");
+    }
+
+    string getReservationID() const { return reservationID; }
+    string getPassengerName() const { return passengerName; }
+    string getFlightID() const { return flightID; }
+    const string& getAirlineName() const { return airlineName; }
+    const string& getDestination() const { return destination; }
+    string getSeatNumber() const { return seatNumber; }
+    const string& getStatus() const { return status; }
+    string getUsername() const { return username; }
+    const string& getPaymentMethod() const { return paymentMethod; }
+
+    string toRecord() const {
+        stringstream ss;
+        ss << reservationID << ","
+           << quoteField(passengerName) << ","
+           << flightID << ","
+           << quoteField(airlineName) << ","
+           << quoteField(destination) << ","
+           << seatNumber << ","
+           << quoteField(status) << ","
+           << quoteField(username) << ","
+           << quoteField(paymentMethod);
+        return ss.str();
+    }
+
+    static bool fromTokens(const vector<string_view>& tokens, Reservation& reservation) {
+        if (tokens.size() < 8) {
+            return false;
+        }
+        
+        reservation.reservationID = string(tokens[0]);
+        reservation.passengerName = string(tokens[1]);
+        reservation.flightID = string(tokens[2]);
+        reservation.airlineName = tokens[3];
+        reservation.destination = tokens[4];
+        reservation.seatNumber = string(tokens[5]);
+        reservation.status = tokens[6];
+        reservation.username = string(tokens[7]);
+        reservation.paymentMethod = tokens.size() >= 9 ? tokens[8] : string_view();
+        
+        return true;
+    }
+
+    void saveToFile() const {
+        try {
+            DatabaseManager* dbManager = DatabaseManager::getInstance();
+            dbManager->saveData("reservations.txt", toRecord());
+        } catch (const exception& e) {
+            printErrorMessage("Error saving reservation: " + string(e.what()));
+        }
+    }
+
+    static vector<Reservation> readReservations() {
+        size_t chunkCount = WorkerPool::concurrency();
+        vector<vector<Reservation>> parsed(chunkCount);
+        
+        DatabaseManager* dbManager = DatabaseManager::getInstance();
+        dbManager->forEachRecordParallel("reservations.txt", chunkCount, [&](size_t chunk, const CsvRecord& record) {
+            Reservation reservation;
+            if (fromTokens(record.getFields(), reservation)) {
+                parsed[chunk].push_back(std::move(reservation));
+            }
+        }, [&](size_t chunk, size_t lines) { parsed[chunk].reserve(lines); });
+        
+        return concatenateChunks(parsed);
+    }
+
+    static void publishReservations(vector<Reservation>& loaded) {
+        reservations.swap(loaded);
+        ReservationStore::rebuild();
+    }
+
+    static void loadReservations() {
+        try {
+            vector<Reservation> loaded = readReservations();
+            publishReservations(loaded);
+        } catch (const exception& e) {
+            printErrorMessage("Error loading reservations: " + string(e.what()));
+        }
+    }
+
+    static void saveAllReservations() {
+        try {
+            DatabaseManager* dbManager = DatabaseManager::getInstance();
+            dbManager->beginBatch("reservations.txt");
+            
+            for (const auto& reservation : reservations) {
+                dbManager->appendToBatch("reservations.txt", reservation.toRecord());
+            }
+            
+            dbManager->commitBatch("reservations.txt");
+        } catch (const exception& e) {
+            printErrorMessage("Error saving all reservations: " + string(e.what()));
+        }
+    }
+};
+
+unordered_map<string, size_t, CaseInsensitiveHash, CaseInsensitiveEqual> ReservationStore::slots;
+unordered_map<string, vector<string>> ReservationStore::byUser;
+unordered_map<string, vector<string>, CaseInsensitiveHash, CaseInsensitiveEqual> ReservationStore::byFlight;
+
+template <typename Index>
+void ReservationStore::unlink(Index& index, const string& key, const string& reservationID) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return;
+    }
+    
+    vector<string>& ids = it->second;
+    ids.erase(std::remove(ids.begin(), ids.end(), reservationID), ids.end());
+    if (ids.empty()) {
+        index.erase(it);
+    }
+}
+
+void ReservationStore::rebuild() {
+    WorkerPool::run({
+        [] {
+            slots.clear();
+            slots.reserve(reservations.size());
+            for (size_t i = 0; i < reservations.size(); i++) {
+                slots[reservations[i].getReservationID()] = i;
+            }
+        },
+        [] {
+            byUser.clear();
+            for (const auto& reservation : reservations) {
+                byUser[reservation.getUsername()].push_back(reservation.getReservationID());
+            }
+        },
+        [] {
+            byFlight.clear();
+            for (const auto& reservation : reservations) {
+                byFlight[reservation.getFlightID()].push_back(reservation.getReservationID());
+            }
+        }
+    });
+}
+
+Reservation* ReservationStore::find(const string& reservationID) {
+    auto it = slots.find(reservationID);
+    if (it == slots.end()) {
+        return nullptr;
+    }
+    return &reservations[it->second];
+}
+
+vector<Reservation> ReservationStore::forUser(const string& username) {
+    vector<Reservation> result;
+    
+    auto userIt = byUser.find(username);
+    if (userIt == byUser.end()) {
+        return result;
+    }
+    
+    result.reserve(userIt->second.size());
+    for (const auto& reservationID : userIt->second) {
+        auto slotIt = slots.find(reservationID);
+        if (slotIt != slots.end()) {
+            result.push_back(reservations[slotIt->second]);
+        }
+    }
+    return result;
+}
+
+vector<string> ReservationStore::idsForFlight(const string& flightID) {
+    auto it = byFlight.find(flightID);
+    return it == byFlight.end() ? vector<string>() : it->second;
+}
+
+vector<Reservation> ReservationStore::forFlight(const string& flightID) {
+    vector<Reservation> result;
+    
+    auto flightIt = byFlight.find(flightID);
+    if (flightIt == byFlight.end()) {
+        return result;
+    }
+    
+    result.reserve(flightIt->second.size());
+    for (const auto& reservationID : flightIt->second) {
+        auto slotIt = slots.find(reservationID);
+        if (slotIt != slots.end()) {
+            result.push_back(reservations[slotIt->second]);
+        }
+    }
+    return result;
+}
+
+void ReservationStore::add(const Reservation& reservation) {
+    reservations.push_back(reservation);
+    slots[reservation.getReservationID()] = reservations.size() - 1;
+    byUser[reservation.getUsername()].push_back(reservation.getReservationID());
+    byFlight[reservation.getFlightID()].push_back(reservation.getReservationID());
+}
+
+bool ReservationStore::remove(const string& reservationID) {
+    auto it = slots.find(reservationID);
+    if (it == slots.end()) {
+        return false;
+    }
+    
+    size_t slot = it->second;
+    string storedID = reservations[slot].getReservationID();
+    
+    unlink(byUser, reservations[slot].getUsername(), storedID);
+    unlink(byFlight, reservations[slot].getFlightID(), storedID);
+    
+    slots.erase(it);
+    
+    size_t last = reservations.size() - 1;
+    if (slot != last) {
+        reservations[slot] = std::move(reservations[last]);
+        slots[reservations[slot].getReservationID()] = slot;
+    }
+    reservations.pop_back();
+    
+    return true;
+}
+
+size_t ReservationStore::removeForFlight(const string& flightID) {
+    vector<string> ids = idsForFlight(flightID);
+    for (const auto& reservationID : ids) {
+        remove(reservationID);
+    }
+    return ids.size();
+}
+
+size_t ReservationStore::removeForUser(const string& username) {
+    auto it = byUser.find(username);
+    if (it == byUser.end()) {
+        return 0;
+    }
+    
+    vector<string> ids = it->second;
+    for (const auto& reservationID : ids) {
+        remove(reservationID);
+    }
+    return ids.size();
+}
+
+class WaitingList {
+private:
+    string flightID;
+    list<pair<string, string>> passengers;
+    unordered_map<string, list<pair<string, string>>::iterator> index;
+    bool dirty;
+
+    void rebuildIndex() {
+        index.clear();
+        for (auto it = passengers.begin(); it != passengers.end(); ++it) {
+            index[it->first] = it;
+        }
+    }
+
+public:
+    WaitingList() : dirty(false) {}
+
+    WaitingList(const string& flightID) : flightID(flightID), dirty(false) {}
+
+    WaitingList(const WaitingList& other) : flightID(other.flightID), passengers(other.passengers), dirty(other.dirty) {
+        rebuildIndex();
+    }
+
+    WaitingList& operator=(const WaitingList& other) {
+        if (this != &other) {
+            flightID = other.flightID;
+            passengers = other.passengers;
+            dirty = other.dirty;
+            rebuildIndex();
+        }
+        return *this;
+    }
+
+    WaitingList(WaitingList&& other) = default;
+    WaitingList& operator=(WaitingList&& other) = default;
+
+    bool isDirty() const { return dirty; }
+    void markClean() { dirty = false; }
+
+    string getFlightID() const { return flightID; }
+    const list<pair<string, string>>& getPassengers() const { return passengers; }
+
+    bool contains(const string& username) const {
+        return index.find(username) != index.end();
+    }
+
+    bool addPassenger(const string& username, const string& passengerName) {
+        if (contains(username)) {
+            return false;
+        }
+        
+        passengers.push_back(make_pair(username, passengerName));
+        index[username] = prev(passengers.end());
+        dirty = true;
+        return true;
+    }
+
+    bool removePassenger(const string& username) {
+        auto it = index.find(username);
+        if (it == index.end()) {
+            return false;
+        }
+        
+        passengers.erase(it->second);
+        index.erase(it);
+        dirty = true;
+        return true;
+    }
+
+    pair<string, string> getNextPassenger() const {
+        if (passengers.empty()) {
+            return make_pair("", "");
+        }
+        return passengers.front();
+    }
+
+    pair<string, string> popNextPassenger() {
+        if (passengers.empty()) {
+            return make_pair("", "");
+        }
+        
+        pair<string, string> next = passengers.front();
+        index.erase(next.first);
+        passengers.pop_front();
+        dirty = true;
+        return next;
+    }
+
+    bool isEmpty() const {
+        return passengers.empty();
+    }
+
+    void display() const {
+        printSubHeader("Waiting List for Flight " + flightID);
+        
+        if (passengers.empty()) {
+            printInfoMessage("No passengers in the waiting list.");
+            return;
+        }
+        
+        vector<pair<string, int>> columns = {
+            {"No.", 5},
+            {"Passenger Name", 25},
+            {"Username", 20}
+        };
+        
+        printTableHeader(columns);
+        
+        size_t position = 1;
+        for (const auto& passenger : passengers) {
+            vector<pair<string, int>> row = {
+                {to_string(position++), 5},
+                {passenger.second, 25},
+                {passenger.first, 20}
+            };
+            
+            printTableRow(row);
+        }
+    }
+
+    void saveToFile() {
+        try {
+            SegmentStore& store = SegmentStore::waitingLists();
+            
+            if (passengers.empty()) {
+                store.erase(flightID);
+                dirty = false;
+                return;
+            }
+            
+            string data;
+            for (const auto& passenger : passengers) {
+                data += quoteField(passenger.first) + "," + quoteField(passenger.second) + "\n";
+            }
+            
+            if (store.put(flightID, data)) {
+                dirty = false;
+            }
+        } catch (const exception& e) {
+            printErrorMessage("Error saving waiting list: " + string(e.what()));
+        }
+    }
+
+    static vector<WaitingList> readWaitingLists(const vector<Flight>& source) {
+        unordered_map<string, WaitingList> stored;
+        SegmentStore::waitingLists().forEach([&stored](const string& flightID, string_view payload) {
+            WaitingList waitingList(flightID);
+            
+            CsvReader reader(payload);
+            CsvRecord record;
+            while (reader.next(record)) {
+                string passengerName = record.str(1);
+                for (size_t i = 2; i < record.size(); i++) {
+                    passengerName += "," + string(record[i]);
+                }
+                
+                waitingList.addPassenger(record.str(0), passengerName);
+            }
+            
+            waitingList.markClean();
+            stored.emplace(flightID, std::move(waitingList));
+        });
+        
+        vector<WaitingList> loaded;
+        loaded.reserve(source.size());
+        for (const auto& flight : source) {
+            auto it = stored.find(flight.getFlightID());
+            loaded.push_back(it != stored.end() ? std::move(it->second) : WaitingList(flight.getFlightID()));
+        }
+        return loaded;
+    }
+
+    static void publishWaitingLists(vector<WaitingList>& loaded) {
+        waitingLists.clear();
+        for (auto& waitingList : loaded) {
+            string flightID = waitingList.getFlightID();
+            waitingLists[flightID] = std::move(waitingList);
+        }
+    }
+
+    static void loadWaitingLists() {
+        try {
+            vector<WaitingList> loaded = readWaitingLists(flights);
+            publishWaitingLists(loaded);
+        } catch (const exception& e) {
+            printErrorMessage("Error loading waiting lists: " + string(e.what()));
+        }
+    }
+
+    static void saveAllWaitingLists() {
+        try {
+            for (auto& pair : waitingLists) {
+                if (pair.second.isDirty()) {
+                    pair.second.saveToFile();
+                }
+            }
+            SegmentStore::waitingLists().flush();
+        } catch (const exception& e) {
+            printErrorMessage("Error saving all waiting lists: " + string(e.what()));
+        }
+    }
+};
+
+class Journal {
+private:
+    Journal() : journalBytes(0), snapshotBytes(0), generation(0), buffered(false) {}
+
+    static constexpr const char* activeFilename = "journal.txt";
+    static constexpr const char* sealedFilename = "journal.sealed.txt";
+    static constexpr size_t minimumCompactBytes = 64 * 1024;
+
+    ofstream file;
+    mutex writeMutex;
+    mutex compactMutex;
+    size_t journalBytes;
+    size_t snapshotBytes;
+    int64_t generation;
+    bool buffered;
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    void applyRecord(const vector<string>& tokens);
+    void sync();
+    int64_t seal();
+    bool beginCompaction(string& snapshot, int64_t& sealedGeneration);
+    void finishCompaction(const string& snapshot, int64_t sealedGeneration);
+
+public:
+    static Journal* getInstance() {
+        static Journal journal;
+        return &journal;
+    }
+
+    void append(const string& record) {
+        appendAll({record});
+    }
+
+    void appendAll(const vector<string>& records) {
+        lock_guard<mutex> guard(writeMutex);
+        try {
+            if (!file.is_open()) {
+                file.open("journal.txt", ios::app);
+                if (!file.is_open()) {
+                    throw FileOperationException("Failed to open file: journal.txt");
+                }
+            }
+            
+            for (const auto& record : records) {
+                file << record << '\n';
+                journalBytes += record.size() + 1;
+            }
+            if (!buffered) {
+                sync();
+            }
+        } catch (const exception& e) {
+            printErrorMessage("Error writing journal: " + string(e.what()));
+        }
+    }
+
+    static string seatBookedRecord(const string& flightID, const string& seatNumber) {
+        return "BOOK," + flightID + "," + seatNumber;
+    }
+
+    static string reservationAddedRecord(const Reservation& reservation) {
+        return "ADDRES," + reservation.toRecord();
+    }
+
+    static string seatCancelledRecord(const string& flightID, const string& seatNumber) {
+        return "CANCEL," + flightID + "," + seatNumber;
+    }
+
+    static string reservationRemovedRecord(const string& reservationID) {
+        return "DELRES," + reservationID;
+    }
+
+    static string passengerDequeuedRecord(const string& flightID, const string& username) {
+        return "WAITDEL," + flightID + "," + quoteField(username);
+    }
+
+    void recordSeatBooked(const string& flightID, const string& seatNumber) {
+        append(seatBookedRecord(flightID, seatNumber));
+    }
+
+    void recordSeatCancelled(const string& flightID, const string& seatNumber) {
+        append(seatCancelledRecord(flightID, seatNumber));
+    }
+
+    void recordFlightUpdated(const Flight& flight) {
+        append("UPDATE," + flight.getFlightID() + "," + quoteField(flight.getAirlineName()) + "," +
+               quoteField(flight.getDepartureTime()) + "," + quoteField(flight.getArrivalTime()) + "," +
+               quoteField(flight.getStatus()));
+    }
+
+    void recordReservationAdded(const Reservation& reservation) {
+        append(reservationAddedRecord(reservation));
+    }
+
+    void recordReservationRemoved(const string& reservationID) {
+        append(reservationRemovedRecord(reservationID));
+    }
+
+    void recordFlightAdded(const Flight& flight) {
+        append("ADDFLIGHT," + flight.toRecord());
+    }
+
+    void recordFlightDeleted(const string& flightID) {
+        append("DELFLIGHT," + flightID);
+    }
+
+    void recordFlightArchived(const string& flightID) {
+        append("ARCHIVE," + flightID);
+    }
+
+    void recordUserDeleted(const string& username) {
+        append("DELUSER," + quoteField(username));
+    }
+
+    void recordUserAdded(const User& user);
+
+    void recordPasswordChanged(const string& username, const string& passwordHash) {
+        append("UPDUSER," + quoteField(username) + "," + quoteField(passwordHash));
+    }
+
+    void recordPassengerQueued(const string& flightID, const string& username, const string& passengerName) {
+        append("WAITADD," + flightID + "," + quoteField(username) + "," + quoteField(passengerName));
+    }
+
+    void recordPassengerDequeued(const string& flightID, const string& username) {
+        append(passengerDequeuedRecord(flightID, username));
+    }
+
+    void replay();
+
+    void setSnapshot(int64_t snapshotGeneration, size_t bytes) {
+        lock_guard<mutex> guard(writeMutex);
+        generation = snapshotGeneration;
+        snapshotBytes = bytes;
+    }
+
+    bool compactionDue() {
+        lock_guard<mutex> guard(writeMutex);
+        return journalBytes >= max(minimumCompactBytes, snapshotBytes / 2);
+    }
+
+    void setBuffered(bool enabled) {
+        lock_guard<mutex> guard(writeMutex);
+        buffered = enabled;
+        if (!buffered) {
+            sync();
+        }
+    }
+
+    void compact();
+
+    ~Journal() {}
+};
+
+class PromotionWorker {
+private:
+    struct SeatFreed {
+        string flightID;
+        string seatNumber;
+    };
+
+    static mutex queueMutex;
+    static condition_variable queueChanged;
+    static deque<SeatFreed> pending;
+    static thread worker;
+    static bool running;
+    static bool busy;
+
+    static void process() {
+        unique_lock<mutex> guard(queueMutex);
+        while (true) {
+            queueChanged.wait(guard, [] { return !running || !pending.empty(); });
+            if (pending.empty()) {
+                return;
+            }
+            
+            SeatFreed event = pending.front();
+            pending.pop_front();
+            busy = true;
+            guard.unlock();
+            
+            try {
+                BookingService::promoteWaitlisted(event.flightID, event.seatNumber);
+            } catch (const exception& e) {
+                printErrorMessage("Error promoting waiting list: " + string(e.what()));
+            }
+            
+            guard.lock();
+            busy = false;
+            queueChanged.notify_all();
+        }
+    }
+
+public:
+    static void start() {
+        lock_guard<mutex> guard(queueMutex);
+        if (running) {
+            return;
+        }
+        running = true;
+        worker = thread(process);
+    }
+
+    static void stop() {
+        {
+            lock_guard<mutex> guard(queueMutex);
+            if (!running) {
+                return;
+            }
+            running = false;
+        }
+        queueChanged.notify_all();
+        worker.join();
+    }
+
+    static void post(const string& flightID, const string& seatNumber) {
+        {
+            lock_guard<mutex> guard(queueMutex);
+            if (running) {
+                pending.push_back({flightID, seatNumber});
+                queueChanged.notify_all();
+                return;
+            }
+        }
+        BookingService::promoteWaitlisted(flightID, seatNumber);
+    }
+
+    static void drain() {
+        unique_lock<mutex> guard(queueMutex);
+        queueChanged.wait(guard, [] { return !running || (pending.empty() && !busy); });
+    }
+};
+
+class CompactionWorker {
+private:
+    static mutex stateMutex;
+    static condition_variable stateChanged;
+    static thread worker;
+    static bool running;
+    static bool requested;
+
+    static void process() {
+        unique_lock<mutex> guard(stateMutex);
+        while (true) {
+            stateChanged.wait(guard, [] { return !running || requested; });
+            if (!running) {
+                return;
+            }
+            
+            requested = false;
+            guard.unlock();
+            
+            Journal* journal = Journal::getInstance();
+            if (journal->compactionDue()) {
+                journal->compact();
+            }
+            
+            guard.lock();
+        }
+    }
+
+public:
+    static void start() {
+        lock_guard<mutex> guard(stateMutex);
+        if (running) {
+            return;
+        }
+        running = true;
+        worker = thread(process);
+    }
+
+    static void stop() {
+        {
+            lock_guard<mutex> guard(stateMutex);
+            if (!running) {
+                return;
+            }
+            running = false;
+        }
+        stateChanged.notify_all();
+        worker.join();
+    }
+
+    static bool post() {
+        lock_guard<mutex> guard(stateMutex);
+        if (!running) {
+            return false;
+        }
+        requested = true;
+        stateChanged.notify_all();
+        return true;
+    }
+};
+
+mutex CompactionWorker::stateMutex;
+condition_variable CompactionWorker::stateChanged;
+thread CompactionWorker::worker;
+bool CompactionWorker::running = false;
+bool CompactionWorker::requested = false;
+
+mutex PromotionWorker::queueMutex;
+condition_variable PromotionWorker::queueChanged;
+deque<PromotionWorker::SeatFreed> PromotionWorker::pending;
+thread PromotionWorker::worker;
+bool PromotionWorker::running = false;
+bool PromotionWorker::busy = false;
+
+shared_mutex BookingService::catalogMutex;
+mutex BookingService::locksMutex;
+mutex BookingService::storeMutex;
+unordered_map<string, unique_ptr<shared_mutex>, CaseInsensitiveHash, CaseInsensitiveEqual> BookingService::flightLocks;
+
+shared_mutex& BookingService::flightLock(const string& flightID) {
+    lock_guard<mutex> guard(locksMutex);
+    unique_ptr<shared_mutex>& lock = flightLocks[flightID];
+    if (!lock) {
+        lock = make_unique<shared_mutex>();
+    }
+    return *lock;
+}
+
+unique_lock<shared_mutex> BookingService::tryLockFlight(const string& flightID) {
+    return unique_lock<shared_mutex>(flightLock(flightID), try_to_lock);
+}
+
+shared_lock<shared_mutex> BookingService::lockResident(const Flight& flight) {
+    shared_mutex& lock = flightLock(flight.getFlightID());
+    shared_lock<shared_mutex> guard(lock);
+    
+    while (!flight.isSeatMapResident()) {
+        guard.unlock();
+        {
+            unique_lock<shared_mutex> loadGuard(lock);
+            flight.prepareSeatMap();
+        }
+        guard.lock();
+    }
+    SeatMapCache::touch(flight.getFlightID());
+    return guard;
+}
+
+void BookingService::forget(const string& flightID) {
+    lock_guard<mutex> guard(locksMutex);
+    flightLocks.erase(flightID);
+}
+
+void BookingService::recordBooking(const Flight& flight, const string& seatNumber, const string& username,
+                                   const string& passengerName, const string& paymentDetails, Reservation& booked) {
+    lock_guard<mutex> storeGuard(storeMutex);
+    booked = Reservation(passengerName, flight.getFlightID(), flight.getAirlineName(),
+                         flight.getDestination(), seatNumber, username, paymentDetails);
+    ReservationStore::add(booked);
+    
+    Journal::getInstance()->appendAll({
+        Journal::seatBookedRecord(flight.getFlightID(), seatNumber),
+        Journal::reservationAddedRecord(booked)
+    });
+}
+
+SeatResult BookingService::book(const string& flightID, const string& seatNumber, const string& username,
+                                const string& passengerName, const string& paymentDetails, Reservation& booked) {
+    METRIC_SPAN("booking_book");
+    {
+        shared_lock<shared_mutex> catalogGuard(catalogMutex);
+        
+        Flight* flight = FlightRegistry::find(flightID);
+        if (flight == nullptr) {
+            return SeatResult::UnknownFlight;
+        }
+        
+        shared_lock<shared_mutex> flightGuard = lockResident(*flight);
+        
+        SeatResult result = flight->tryBook(seatNumber);
+        if (result != SeatResult::Ok) {
+            METRIC_COUNT("booking_rejections");
+            return result;
+        }
+        recordBooking(*flight, seatNumber, username, passengerName, paymentDetails, booked);
+    }
+    
+    compactIfDue();
+    return SeatResult::Ok;
+}
+
+SeatResult BookingService::bookFirstAvailable(const string& flightID, const string& username,
+                                              const string& passengerName, const string& paymentDetails, Reservation& booked) {
+    METRIC_SPAN("booking_book_first_available");
+    {
+        shared_lock<shared_mutex> catalogGuard(catalogMutex);
+        
+        Flight* flight = FlightRegistry::find(flightID);
+        if (flight == nullptr) {
+            return SeatResult::UnknownFlight;
+        }
+        
+        shared_lock<shared_mutex> flightGuard = lockResident(*flight);
+        
+        string seatNumber;
+        SeatResult result = flight->tryBookFirstAvailable(seatNumber);
+        if (result != SeatResult::Ok) {
+            METRIC_COUNT("booking_rejections");
+            return result;
+        }
+        recordBooking(*flight, seatNumber, username, passengerName, paymentDetails, booked);
+    }
+    
+    compactIfDue();
+    return SeatResult::Ok;
+}
+
+bool BookingService::release(const string& reservationID, const string& username, bool requireOwner) {
+    METRIC_SPAN("booking_cancel");
+    string flightID;
+    string seatNumber;
+    bool seatFreed = false;
+    {
+        shared_lock<shared_mutex> catalogGuard(catalogMutex);
+        
+        {
+            lock_guard<mutex> storeGuard(storeMutex);
+            Reservation* reservation = ReservationStore::find(reservationID);
+            if (reservation == nullptr || (requireOwner && reservation->getUsername() != username)) {
+                return false;
+            }
+            flightID = reservation->getFlightID();
+        }
+        
+        Journal* journal = Journal::getInstance();
+        Flight* flight = FlightRegistry::find(flightID);
+        shared_lock<shared_mutex> flightGuard;
+        if (flight != nullptr) {
+            flightGuard = lockResident(*flight);
+        }
+        
+        {
+            lock_guard<mutex> storeGuard(storeMutex);
+            Reservation* reservation = ReservationStore::find(reservationID);
+            if (reservation == nullptr) {
+                return false;
+            }
+            seatNumber = reservation->getSeatNumber();
+            
+            ReservationStore::remove(reservationID);
+            vector<string> records = {Journal::reservationRemovedRecord(reservationID)};
+            if (flight != nullptr && flight->tryCancel(seatNumber) == SeatResult::Ok) {
+                flightID = flight->getFlightID();
+                records.push_back(Journal::seatCancelledRecord(flightID, seatNumber));
+                seatFreed = true;
+            }
+            journal->appendAll(records);
+        }
+    }
+    
+    if (seatFreed) {
+        PromotionWorker::post(flightID, seatNumber);
+    }
+    
+    compactIfDue();
+    return true;
+}
+
+bool BookingService::cancel(const string& username, const string& reservationID) {
+    return release(reservationID, username, true);
+}
+
+bool BookingService::removeReservation(const string& reservationID) {
+    return release(reservationID, "", false);
+}
+
+size_t BookingService::unlinkFlight(const string& flightID) {
+    size_t removed = 0;
+    {
+        lock_guard<mutex> storeGuard(storeMutex);
+        removed = ReservationStore::removeForFlight(flightID);
+        waitingLists.erase(flightID);
+    }
+    
+    DestinationIndex::remove(flightID);
+    FlightRegistry::remove(flightID);
+    return removed;
+}
+
+bool BookingService::deleteFlight(const string& flightID) {
+    unique_lock<shared_mutex> catalogGuard(catalogMutex);
+    
+    Flight* flight = FlightRegistry::find(flightID);
+    if (flight == nullptr) {
+        return false;
+    }
+    
+    string actualFlightID = flight->getFlightID();
+    unlinkFlight(actualFlightID);
+    
+    SegmentStore::seatMaps().erase(actualFlightID);
+    SegmentStore::waitingLists().erase(actualFlightID);
+    
+    Journal::getInstance()->recordFlightDeleted(actualFlightID);
+    return true;
+}
+
+bool BookingService::promoteWaitlisted(const string& flightID, const string& seatNumber) {
+    METRIC_SPAN("waitlist_promote");
+    {
+        shared_lock<shared_mutex> catalogGuard(catalogMutex);
+        
+        Flight* flight = FlightRegistry::find(flightID);
+        if (flight == nullptr) {
+            return false;
+        }
+        
+        shared_lock<shared_mutex> flightGuard = lockResident(*flight);
+        lock_guard<mutex> storeGuard(storeMutex);
+        
+        auto it = waitingLists.find(flight->getFlightID());
+        if (it == waitingLists.end() || it->second.isEmpty()) {
+            return false;
+        }
+        
+        if (flight->tryBook(seatNumber) != SeatResult::Ok) {
+            return false;
+        }
+        
+        WaitingList& waitingList = it->second;
+        pair<string, string> passenger = waitingList.popNextPassenger();
+        
+        Reservation reservation(passenger.second, flight->getFlightID(), flight->getAirlineName(),
+                                flight->getDestination(), seatNumber, passenger.first);
+        ReservationStore::add(reservation);
+        
+        Journal::getInstance()->appendAll({
+            Journal::seatBookedRecord(flight->getFlightID(), seatNumber),
+            Journal::reservationAddedRecord(reservation),
+            Journal::passengerDequeuedRecord(flight->getFlightID(), passenger.first)
+        });
+    }
+    
+    compactIfDue();
+    return true;
+}
+
+WaitlistResult BookingService::joinWaitingList(const string& flightID, const string& username,
+                                               const string& passengerName) {
+    METRIC_SPAN("waitlist_join");
+    {
+        shared_lock<shared_mutex> catalogGuard(catalogMutex);
+        
+        Flight* flight = FlightRegistry::find(flightID);
+        if (flight == nullptr) {
+            return WaitlistResult::UnknownFlight;
+        }
+        
+        lock_guard<mutex> storeGuard(storeMutex);
+        if (waitingLists.find(flight->getFlightID()) == waitingLists.end()) {
+            waitingLists[flight->getFlightID()] = WaitingList(flight->getFlightID());
+        }
+        
+        WaitingList& waitingList = waitingLists[flight->getFlightID()];
+        if (!waitingList.addPassenger(username, passengerName)) {
+            return WaitlistResult::AlreadyQueued;
+        }
+        Journal::getInstance()->recordPassengerQueued(flight->getFlightID(), username, passengerName);
+    }
+    
+    compactIfDue();
+    return WaitlistResult::Queued;
+}
+
+bool BookingService::leaveWaitingList(const string& flightID, const string& username) {
+    shared_lock<shared_mutex> catalogGuard(catalogMutex);
+    lock_guard<mutex> storeGuard(storeMutex);
+    
+    auto it = waitingLists.find(flightID);
+    if (it == waitingLists.end() || !it->second.removePassenger(username)) {
+        return false;
+    }
+    Journal::getInstance()->recordPassengerDequeued(it->first, username);
+    return true;
+}
+
+WaitingList BookingService::waitingListFor(const string& flightID) {
+    shared_lock<shared_mutex> catalogGuard(catalogMutex);
+    lock_guard<mutex> storeGuard(storeMutex);
+    
+    auto it = waitingLists.find(flightID);
+    return it == waitingLists.end() ? WaitingList(flightID) : it->second;
+}
+
+bool BookingService::updateFlight(const string& flightID, const string& airlineName, int64_t departureAt,
+                                  int64_t arrivalAt, const string& status) {
+    unique_lock<shared_mutex> catalogGuard(catalogMutex);
+    
+    Flight* flight = FlightRegistry::find(flightID);
+    if (flight == nullptr) {
+        return false;
+    }
+    
+    flight->setAirlineName(airlineName);
+    flight->setDepartureAt(departureAt);
+    flight->setArrivalAt(arrivalAt);
+    flight->setStatus(status);
+    Journal::getInstance()->recordFlightUpdated(*flight);
+    return true;
+}
+
+bool BookingService::inspectFlight(const string& flightID, const function<void(const Flight&)>& visit) {
+    shared_lock<shared_mutex> catalogGuard(catalogMutex);
+    
+    Flight* flight = FlightRegistry::find(flightID);
+    if (flight == nullptr) {
+        return false;
+    }
+    
+    shared_lock<shared_mutex> flightGuard = lockResident(*flight);
+    visit(*flight);
+    return true;
+}
+
+vector<Reservation> BookingService::reservationsFor(const string& username) {
+    shared_lock<shared_mutex> catalogGuard(catalogMutex);
+    lock_guard<mutex> storeGuard(storeMutex);
+    return ReservationStore::forUser(username);
+}
+
+vector<Reservation> BookingService::reservationsForFlight(const string& flightID) {
+    shared_lock<shared_mutex> catalogGuard(catalogMutex);
+    lock_guard<mutex> storeGuard(storeMutex);
+    return ReservationStore::forFlight(flightID);
+}
+
+bool BookingService::seatMapFor(const string& flightID, vector<string>& rows, int& availableSeats) {
+    shared_lock<shared_mutex> catalogGuard(catalogMutex);
+    
+    Flight* flight = FlightRegistry::find(flightID);
+    if (flight == nullptr) {
+        return false;
+    }
+    
+    shared_lock<shared_mutex> flightGuard = lockResident(*flight);
+    rows = flight->getSeatMapRows();
+    availableSeats = flight->getAvailableSeats();
+    return true;
+}
+
+void BookingService::compactIfDue() {
+    Journal* journal = Journal::getInstance();
+    if (journal->compactionDue() && !CompactionWorker::post()) {
+        journal->compact();
+    }
+}
+
+class PasswordHasher {
+private:
+    static constexpr const char* scheme = "$pbkdf2-sha256$";
+    static constexpr int defaultIterations = 20000;
+    static constexpr size_t saltLength = 16;
+    static constexpr size_t blockSize = 64;
+
+    struct Sha256 {
+        uint32_t state[8];
+        uint8_t buffer[64];
+        uint64_t totalLength;
+        size_t bufferLength;
+
+        Sha256() : totalLength(0), bufferLength(0) {
+            static const uint32_t initial[8] = {
+                0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+            };
+            memcpy(state, initial, sizeof(state));
+        }
+
+        static uint32_t rotr(uint32_t x, int n) {
+            return (x >> n) | (x << (32 - n));
+        }
+
+        void compress(const uint8_t* block) {
+            static const uint32_t k[64] = {
+                0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+            };
+            
+            uint32_t w[64];
+            for (int i = 0; i < 16; i++) {
+                w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16) |
+                       (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+            }
+            for (int i = 16; i < 64; i++) {
+                uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+            
+            uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+            uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+            for (int i = 0; i < 64; i++) {
+                uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+                uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                h = g;
+                g = f;
+                f = e;
+                e = d + t1;
+                d = c;
+                c = b;
+                b = a;
+                a = t1 + t2;
+            }
+            
+            state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+            state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        }
+
+        void update(const uint8_t* data, size_t length) {
+            totalLength += length;
+            while (length > 0) {
+                size_t take = min(length, sizeof(buffer) - bufferLength);
+                memcpy(buffer + bufferLength, data, take);
+                bufferLength += take;
+                data += take;
+                length -= take;
+                
+                if (bufferLength == sizeof(buffer)) {
+                    compress(buffer);
+                    bufferLength = 0;
+                }
+            }
+        }
+
+        void finish(uint8_t* digest) {
+            uint64_t bitLength = totalLength * 8;
+            uint8_t padding = 0x80;
+            update(&padding, 1);
+            
+            padding = 0;
+            while (bufferLength != 56) {
+                update(&padding, 1);
+            }
+            
+            uint8_t lengthBytes[8];
+            for (int i = 0; i < 8; i++) {
+                lengthBytes[i] = static_cast<uint8_t>(bitLength >> (56 - i * 8));
+            }
+            update(lengthBytes, 8);
+            
+            for (int i = 0; i < 8; i++) {
+                digest[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+                digest[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+                digest[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+                digest[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+            }
+        }
+    };
+
+    typedef array<uint8_t, 32> Digest;
+
+    struct HmacKey {
+        Sha256 inner;
+        Sha256 outer;
+    };
+
+    static HmacKey prepareKey(const string& key) {
+        uint8_t block[blockSize] = {0};
+        if (key.size() > blockSize) {
+            Sha256 keyHash;
+            keyHash.update(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+            keyHash.finish(block);
+        } else {
+            memcpy(block, key.data(), key.size());
+        }
+        
+        uint8_t innerPad[blockSize];
+        uint8_t outerPad[blockSize];
+        for (size_t i = 0; i < blockSize; i++) {
+            innerPad[i] = block[i] ^ 0x36;
+            outerPad[i] = block[i] ^ 0x5c;
+        }
+        
+        HmacKey prepared;
+        prepared.inner.update(innerPad, blockSize);
+        prepared.outer.update(outerPad, blockSize);
+        return prepared;
+    }
+
+    static Digest hmac(const HmacKey& key, const uint8_t* data, size_t length) {
+        Digest innerDigest;
+        Sha256 inner = key.inner;
+        inner.update(data, length);
+        inner.finish(innerDigest.data());
+        
+        Digest result;
+        Sha256 outer = key.outer;
+        outer.update(innerDigest.data(), innerDigest.size());
+        outer.finish(result.data());
+        return result;
+    }
+
+    static Digest pbkdf2(const string& password, const string& salt, int iterations) {
+        HmacKey key = prepareKey(password);
+        
+        string firstBlock = salt;
+        firstBlock.append("\0\0\0\1", 4);
+        Digest u = hmac(key, reinterpret_cast<const uint8_t*>(firstBlock.data()), firstBlock.size());
+        Digest result = u;
+        
+        for (int i = 1; i < iterations; i++) {
+            u = hmac(key, u.data(), u.size());
+            for (size_t j = 0; j < result.size(); j++) {
+                result[j] ^= u[j];
+            }
+        }
+        return result;
+    }
+
+    static string toHex(const uint8_t* data, size_t length) {
+        static const char digits[] = "0123456789abcdef";
+        string hex;
+        hex.reserve(length * 2);
+        for (size_t i = 0; i < length; i++) {
+            hex += digits[data[i] >> 4];
+            hex += digits[data[i] & 0x0f];
+        }
+        return hex;
+    }
+
+    static bool fromHex(string_view hex, string& bytes) {
+        if (hex.size() % 2 != 0) {
+            return false;
+        }
+        
+        bytes.clear();
+        for (size_t i = 0; i < hex.size(); i += 2) {
+            int value = 0;
+            auto result = from_chars(hex.data() + i, hex.data() + i + 2, value, 16);
+            if (result.ec != errc() || result.ptr != hex.data() + i + 2) {
+                return false;
+            }
+            bytes += static_cast<char>(value);
+        }
+        return true;
+    }
+
+    static bool parse(const string& stored, int& iterations, string& salt, string& hash) {
+        if (!isHashed(stored)) {
+            return false;
+        }
+        
+        string_view rest(stored);
+        rest.remove_prefix(strlen(scheme));
+        
+        size_t first = rest.find('$');
+        size_t second = first == string_view::npos ? first : rest.find('$', first + 1);
+        if (second == string_view::npos) {
+            return false;
+        }
+        
+        return parseInt(rest.substr(0, first), iterations) && iterations > 0 &&
+               fromHex(rest.substr(first + 1, second - first - 1), salt) &&
+               fromHex(rest.substr(second + 1), hash);
+    }
+
+public:
+    static int iterations() {
+        static const int configured = [] {
+            const char* value = getenv("AIRLINE_PASSWORD_ITERATIONS");
+            int parsed = 0;
+            if (value != nullptr && parseInt(value, parsed) && parsed > 0) {
+                return parsed;
+            }
+            return defaultIterations;
+        }();
+        return configured;
+    }
+
+    static bool isHashed(const string& stored) {
+        return stored.compare(0, strlen(scheme), scheme) == 0;
+    }
+
+    static string hash(const string& password) {
+        static mutex saltMutex;
+        static random_device device;
+        
+        string salt(saltLength, '\0');
+        {
+            lock_guard<mutex> guard(saltMutex);
+            for (size_t i = 0; i < saltLength; i += 4) {
+                uint32_t value = device();
+                memcpy(&salt[i], &value, min(sizeof(value), saltLength - i));
+            }
+        }
+        
+        int cost = iterations();
+        Digest derived = pbkdf2(password, salt, cost);
+        return string(scheme) + to_string(cost) + "$" +
+               toHex(reinterpret_cast<const uint8_t*>(salt.data()), salt.size()) + "$" +
+               toHex(derived.data(), derived.size());
+    }
+
+    static bool verify(const string& password, const string& stored) {
+        int cost = 0;
+        string salt;
+        string expected;
+        if (!parse(stored, cost, salt, expected) || expected.size() != sizeof(Digest)) {
+            return false;
+        }
+        
+        Digest derived = pbkdf2(password, salt, cost);
+        uint8_t difference = 0;
+        for (size_t i = 0; i < derived.size(); i++) {
+            difference |= derived[i] ^ static_cast<uint8_t>(expected[i]);
+        }
+        return difference == 0;
+    }
+
+    static bool needsRehash(const string& stored) {
+        int cost = 0;
+        string salt;
+        string expected;
+        return !parse(stored, cost, salt, expected) || cost < iterations();
+    }
+};
+
+class UserDirectory {
+private:
+    static unordered_map<string, unique_ptr<class User>> byUsername;
+    static vector<class User*> ordered;
+
+public:
+    static class User* find(const string& username);
+    static class User* add(unique_ptr<class User> user);
+    static bool remove(const string& username);
+    static void clear();
+    static const vector<class User*>& all() { return ordered; }
+    static size_t size() { return ordered.size(); }
+};
+
+class Admin;
+class Customer;
+
+class User {
+private:
+    string username;
+    string password;
+    string name;
     bool isAdmin;
 
 public:
@@ -1255,55 +5172,126 @@ public:
 
     virtual void displayMenu() = 0;
 
+    string toRecord() const {
+        stringstream ss;
+        ss << quoteField(username) << ","
+           << quoteField(password) << ","
+           << quoteField(name) << ","
+           << (isAdmin ? "admin" : "customer");
+        return ss.str();
+    }
+
     virtual void saveToFile() const {
         try {
-            DatabaseManager* dbManager = DatabaseManager::getInstance();
-            
-            stringstream ss;
-            ss << username << ","
-               << password << ","
-               << name << ","
-               << (isAdmin ? "admin" : "customer");
-            
-            dbManager->saveData("users.txt", ss.str());
+            DatabaseManager::getInstance()->saveData("users.txt", toRecord());
         } catch (const exception& e) {
             printErrorMessage("Error saving user: " + string(e.what()));
         }
     }
 
+    static vector<unique_ptr<User>> readUsers(bool& upgraded);
+    static void publishUsers(vector<unique_ptr<User>>& loaded, bool upgraded);
     static void loadUsers();
     static void saveAllUsers() {
         try {
-            ofstream file("users.txt", ios::trunc);
-            file.close();
+            DatabaseManager* dbManager = DatabaseManager::getInstance();
+            dbManager->beginBatch("users.txt");
             
-            for (const auto& user : users) {
-                user->saveToFile();
+            for (const auto& user : UserDirectory::all()) {
+                dbManager->appendToBatch("users.txt", user->toRecord());
             }
+            
+            dbManager->commitBatch("users.txt");
         } catch (const exception& e) {
             printErrorMessage("Error saving all users: " + string(e.what()));
         }
     }
 
     static User* login(const string& username, const string& password) {
-        for (auto& user : users) {
-            if (user->getUsername() == username && user->getPassword() == password) {
-                return user;
-            }
+        METRIC_SPAN("user_login");
+        User* user = UserDirectory::find(username);
+        if (user == nullptr || !PasswordHasher::verify(password, user->getPassword())) {
+            METRIC_COUNT("login_failures");
+            return nullptr;
         }
-        return nullptr;
+        
+        if (PasswordHasher::needsRehash(user->getPassword())) {
+            string passwordHash = PasswordHasher::hash(password);
+            unique_lock<shared_mutex> catalogGuard(BookingService::catalog());
+            user->setPassword(passwordHash);
+            Journal::getInstance()->recordPasswordChanged(user->getUsername(), passwordHash);
+        }
+        return user;
     }
 
     static bool usernameExists(const string& username) {
-        for (const auto& user : users) {
-            if (user->getUsername() == username) {
-                return true;
-            }
-        }
-        return false;
+        return UserDirectory::find(username) != nullptr;
     }
 };
 
+unordered_map<string, unique_ptr<User>> UserDirectory::byUsername;
+vector<User*> UserDirectory::ordered;
+
+User* UserDirectory::find(const string& username) {
+    auto it = byUsername.find(username);
+    return it == byUsername.end() ? nullptr : it->second.get();
+}
+
+User* UserDirectory::add(unique_ptr<User> user) {
+    if (!PasswordHasher::isHashed(user->getPassword())) {
+        user->setPassword(PasswordHasher::hash(user->getPassword()));
+    }
+    
+    User* added = user.get();
+    auto inserted = byUsername.emplace(user->getUsername(), move(user));
+    if (!inserted.second) {
+        return nullptr;
+    }
+    
+    ordered.push_back(added);
+    return added;
+}
+
+bool UserDirectory::remove(const string& username) {
+    auto it = byUsername.find(username);
+    if (it == byUsername.end()) {
+        return false;
+    }
+    
+    ordered.erase(std::remove(ordered.begin(), ordered.end(), it->second.get()), ordered.end());
+    byUsername.erase(it);
+    return true;
+}
+
+void UserDirectory::clear() {
+    ordered.clear();
+    byUsername.clear();
+}
+
+size_t BookingService::unlinkUser(const string& username) {
+    lock_guard<mutex> storeGuard(storeMutex);
+    
+    size_t removed = ReservationStore::removeForUser(username);
+    for (auto& pair : waitingLists) {
+        pair.second.removePassenger(username);
+    }
+    
+    UserDirectory::remove(username);
+    return removed;
+}
+
+bool BookingService::deleteUser(const string& username) {
+    unique_lock<shared_mutex> catalogGuard(catalogMutex);
+    
+    if (UserDirectory::find(username) == nullptr) {
+        return false;
+    }
+    
+    unlinkUser(username);
+    Journal::getInstance()->recordUserDeleted(username);
+    return true;
+}
+
 class Admin : public User {
 public:
     Admin() {
@@ -1319,8 +5307,8 @@ public:
             clearScreen();
             printHeader("ADMIN DASHBOARD");
             
-            cout << "  Welcome, " << getName() << "!" << endl;
-            cout << "  " << getCurrentDateTime() << endl;
+            cout << "  Welcome, " << getName() << "!\n";
+            cout << "  " << getCurrentDateTime() << "\n";
             
             printSeparator();
             
@@ -1331,9 +5319,10 @@ public:
             printMenuOption(5, "View Seat Maps");
             printMenuOption(6, "Manage Waiting List");
             printMenuOption(7, "User Accounts");
-            printMenuOption(8, "Logout");
+            printMenuOption(8, "Archive Departed Flights");
+            printMenuOption(9, "Logout");
             
-            choice = getValidIntegerInput("Enter your choice:", 1, 8);
+            choice = getValidIntegerInput("Enter your choice:", 1, 9);
             
             switch (choice) {
                 case 1:
@@ -1358,10 +5347,42 @@ public:
                     manageUserAccounts();
                     break;
                 case 8:
+                    archiveDepartedFlights();
+                    break;
+                case 9:
                     printInfoMessage("Logging out...");
                     break;
             }
-        } while (choice != 8);
+            
+            BookingService::compactIfDue();
+        } while (choice != 9);
+    }
+
+    void archiveDepartedFlights() {
+        clearScreen();
+        printHeader("ARCHIVE DEPARTED FLIGHTS");
+        
+        try {
+            char confirm = getYesNoInput("\nConfirm archiving departed flights (y/n):");
+            
+            if (confirm != 'y') {
+                printInfoMessage("Archiving cancelled.");
+            } else {
+                vector<string> archived = BookingService::archiveDeparted();
+                if (archived.empty()) {
+                    printInfoMessage("No departed flights to archive.");
+                } else {
+                    for (const auto& flightID : archived) {
+                        printInfoMessage("Archived flight " + flightID);
+                    }
+                    printSuccessMessage(to_string(archived.size()) + " flight(s) archived successfully!");
+                }
+            }
+        } catch (const exception& e) {
+            printErrorMessage(e.what());
+        }
+        
+        pressEnterToContinue();
     }
 
     void createFlight() {
@@ -1369,6 +5390,8 @@ public:
         printHeader("CREATE FLIGHT");
         
         string airlineName, planeID, destination, departureTime, arrivalTime;
+        int64_t departureAt = unknownScheduleTime;
+        int64_t arrivalAt = unknownScheduleTime;
         int capacity;
         
         try {
@@ -1461,6 +5484,8 @@ public:
                 printErrorMessage("Departure time cannot be empty. Please try again.");
             } else if (isOnlySpaces(departureTime)) {
                 printErrorMessage("Departure time cannot contain only spaces. Please try again.");
+            } else if (!parseScheduleTime(departureTime, departureAt)) {
+                printErrorMessage("Invalid departure time. Use the format May 10, 2025 - 08:00 AM.");
             } else {
                 validInput = true;
             }
@@ -1475,6 +5500,10 @@ public:
                 printErrorMessage("Arrival time cannot be empty. Please try again.");
             } else if (isOnlySpaces(arrivalTime)) {
                 printErrorMessage("Arrival time cannot contain only spaces. Please try again.");
+            } else if (!parseScheduleTime(arrivalTime, arrivalAt)) {
+                printErrorMessage("Invalid arrival time. Use the format May 10, 2025 - 09:30 AM.");
+            } else if (arrivalAt <= departureAt) {
+                printErrorMessage("Arrival time must be after the departure time. Please try again.");
             } else {
                 validInput = true;
             }
@@ -1483,19 +5512,22 @@ public:
             clearScreen();
             printSubHeader("Flight Summary");
             
-            cout << "  Airline: " << airlineName << endl;
-            cout << "  Plane ID: " << planeID << endl;
-            cout << "  Capacity: " << capacity << " passengers" << endl;
-            cout << "  Destination: " << destination << endl;
-            cout << "  Departure: " << departureTime << endl;
-            cout << "  Arrival: " << arrivalTime << endl;
+            cout << "  Airline: " << airlineName << "\n";
+            cout << "  Plane ID: " << planeID << "\n";
+            cout << "  Capacity: " << capacity << " passengers\n";
+            cout << "  Destination: " << destination << "\n";
+            cout << "  Departure: " << ScheduleClock::format(departureAt) << "\n";
+            cout << "  Arrival: " << ScheduleClock::format(arrivalAt) << "\n";
             
             char confirm = getYesNoInput("\nConfirm flight creation (y/n):");
             
             if (confirm == 'y') {
-                Flight flight(airlineName, planeID, capacity, destination, departureTime, arrivalTime);
-                flights.push_back(flight);
-                flight.saveToFile();
+                unique_lock<shared_mutex> catalogGuard(BookingService::catalog());
+                
+                Flight flight(airlineName, planeID, capacity, destination, departureAt, arrivalAt);
+                Journal::getInstance()->recordFlightAdded(flight);
+                FlightRegistry::add(flight);
+                DestinationIndex::add(flight);
                 
                 WaitingList waitingList(flight.getFlightID());
                 waitingLists[flight.getFlightID()] = waitingList;
@@ -1517,6 +5549,7 @@ public:
         
         if (flights.empty()) {
             Flight::loadFlights();
+            DestinationIndex::build();
         }
 
         if (flights.empty()) {
@@ -1540,16 +5573,19 @@ public:
                 
                 printTableHeader(columns);
                 
-                for (const auto& flight : flights) {
-                    vector<pair<string, int>> row = {
-                        {flight.getFlightID(), 15},
-                        {flight.getAirlineName(), 24},
-                        {flight.getDestination(), 23},
-                        {flight.getDepartureTime(), 28},
-                        {flight.getArrivalTime(), 25}
-                    };
-                    
-                    printTableRow(row);
+                {
+                    shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+                    for (const auto& flight : flights) {
+                        vector<pair<string, int>> row = {
+                            {flight.getFlightID(), 15},
+                            {flight.getAirlineName(), 24},
+                            {flight.getDestination(), 23},
+                            {flight.getDepartureTime(), 28},
+                            {flight.getArrivalTime(), 25}
+                        };
+                        
+                        printTableRow(row);
+                    }
                 }
 
                 string airlineName;
@@ -1563,12 +5599,11 @@ public:
                         return;
                     }
                     
-                    vector<Flight> airlineFlights;
-                    for (const auto& flight : flights) {
-                        if (equalsIgnoreCase(flight.getAirlineName(), airlineName)) {
-                            airlineFlights.push_back(flight);
-                        }
-                    }
+                    FlightCatalog::Query query;
+                    query.airline = airlineName;
+                    
+                    shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+                    vector<Flight*> airlineFlights = FlightCatalog::select(query);
                     
                     if (airlineFlights.empty()) {
                         printErrorMessage("No flights found for airline: " + airlineName + ". Please try again.");
@@ -1586,16 +5621,17 @@ public:
                         
                         printTableHeader(columns);
                         
-                        for (const auto& flight : airlineFlights) {
+                        for (const auto flight : airlineFlights) {
                             vector<pair<string, int>> row = {
-                                {flight.getFlightID(), 15},
-                                {flight.getDestination(), 20},
-                                {flight.getDepartureTime(), 28},
-                                {flight.getArrivalTime(), 25}
+                                {flight->getFlightID(), 15},
+                                {flight->getDestination(), 20},
+                                {flight->getDepartureTime(), 28},
+                                {flight->getArrivalTime(), 25}
                             };
                             
                             printTableRow(row);
                         }
+                        catalogGuard.unlock();
                         
                         string flightID;
                         bool validFlightID = false;
@@ -1611,47 +5647,26 @@ public:
                                 return;
                             }
                             
-                            auto it = find_if(flights.begin(), flights.end(), 
-                                             [&flightID](const Flight& f) { 
-                                                 return equalsIgnoreCase(f.getFlightID(), flightID); 
-                                             });
+                            catalogGuard.lock();
+                            Flight* flight = FlightRegistry::find(flightID);
+                            if (flight != nullptr) {
+                                flightID = flight->getFlightID();
+                            }
+                            catalogGuard.unlock();
                             
-                            if (it == flights.end()) {
+                            if (flight == nullptr) {
                                 printErrorMessage("Flight not found. Please try again.");
                             } else {
                                 validFlightID = true;
                                 
                                 char confirm = getYesNoInput("\nConfirm delete (y/n):");
                                 
-                                if (confirm == 'y') {
-                                    string actualFlightID = it->getFlightID();
-                                    
-                                    reservations.erase(
-                                        remove_if(reservations.begin(), reservations.end(),
-                                                 [&actualFlightID](const Reservation& r) { 
-                                                     return equalsIgnoreCase(r.getFlightID(), actualFlightID); 
-                                                 }),
-                                        reservations.end());
-                                    
-                                    if (waitingLists.find(actualFlightID) != waitingLists.end()) {
-                                        WaitingList& waitingList = waitingLists[actualFlightID];
-                                        waitingList.saveToFile();
-                                    }
-                                    
-                                    DatabaseManager* dbManager = DatabaseManager::getInstance();
-                                    dbManager->deleteFile("seatmaps/" + actualFlightID + ".txt");
-                                    
-                                    dbManager->deleteFile("waitinglists/" + actualFlightID + ".txt");
-                                    
-                                    flights.erase(it);
-                                    
-                                    Flight::saveAllFlights();
-                                    Reservation::saveAllReservations();
-                                    WaitingList::saveAllWaitingLists();
-                                    
+                                if (confirm != 'y') {
+                                    printInfoMessage("Deletion cancelled.");
+                                } else if (BookingService::deleteFlight(flightID)) {
                                     printSuccessMessage("Flight deleted successfully!");
                                 } else {
-                                    printInfoMessage("Deletion cancelled.");
+                                    printErrorMessage("Flight " + flightID + " no longer exists.");
                                 }
                             }
                         }
@@ -1688,36 +5703,36 @@ public:
             
             printTableHeader(columns);
             
-            for (size_t i = 0; i < flights.size(); i++) {
-                vector<pair<string, int>> row = {
-                    {to_string(i + 1), 10},
-                    {flights[i].getFlightID(), 15},
-                    {flights[i].getAirlineName(), 24},
-                    {flights[i].getDestination(), 25}
-                };
-                
-                printTableRow(row);
+            vector<string> flightIDs;
+            {
+                shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+                for (size_t i = 0; i < flights.size(); i++) {
+                    vector<pair<string, int>> row = {
+                        {to_string(i + 1), 10},
+                        {flights[i].getFlightID(), 15},
+                        {flights[i].getAirlineName(), 24},
+                        {flights[i].getDestination(), 25}
+                    };
+                    
+                    printTableRow(row);
+                    flightIDs.push_back(flights[i].getFlightID());
+                }
             }
             
             printBackOption();
 
-            int flightIndex = getValidIntegerInput("\nEnter flight number to view reservations:", 0, flights.size());
+            int flightIndex = getValidIntegerInput("\nEnter flight number to view reservations:", 0, flightIDs.size());
 
             if (flightIndex == 0){
                 return;
             }
             
-            string flightID = flights[flightIndex - 1].getFlightID();
+            string flightID = flightIDs[flightIndex - 1];
             
             clearScreen();
             printHeader("RESERVATIONS FOR FLIGHT " + flightID);
             
-            vector<Reservation> flightReservations;
-            for (const auto& reservation : reservations) {
-                if (equalsIgnoreCase(reservation.getFlightID(), flightID)) {
-                    flightReservations.push_back(reservation);
-                }
-            }
+            vector<Reservation> flightReservations = BookingService::reservationsForFlight(flightID);
             
             if (flightReservations.empty()) {
                 printInfoMessage("No reservations found for this flight.");
@@ -1770,34 +5785,24 @@ public:
                         return;
                     }
                 
-                    auto it = find_if(reservations.begin(), reservations.end(),
-                                     [&reservationID](const Reservation& r) { 
-                                         return equalsIgnoreCase(r.getReservationID(), reservationID); 
-                                     });
+                    auto selected = find_if(flightReservations.begin(), flightReservations.end(),
+                                            [&reservationID](const Reservation& reservation) {
+                                                return equalsIgnoreCase(reservation.getReservationID(), reservationID);
+                                            });
                 
-                    if (it == reservations.end()) {
+                    if (selected == flightReservations.end()) {
                         printErrorMessage("Reservation not found. Please try again.");
                     } else {
                         validReservationID = true;
                     
                         char confirm = getYesNoInput("\nConfirm delete (y/n):");
                     
-                        if (confirm == 'y') {
-                            for (auto& flight : flights) {
-                                if (equalsIgnoreCase(flight.getFlightID(), it->getFlightID())) {
-                                    flight.cancelSeat(it->getSeatNumber());
-                                    break;
-                                }
-                            }
-                        
-                            reservations.erase(it);
-                        
-                            Flight::saveAllFlights();
-                            Reservation::saveAllReservations();
-                        
+                        if (confirm != 'y') {
+                            printInfoMessage("Deletion cancelled.");
+                        } else if (BookingService::removeReservation(selected->getReservationID())) {
                             printSuccessMessage("Reservation deleted successfully!");
                         } else {
-                            printInfoMessage("Deletion cancelled.");
+                            printErrorMessage("Reservation " + selected->getReservationID() + " no longer exists.");
                         }
                     }
                 }
@@ -1831,35 +5836,58 @@ public:
             
             printTableHeader(columns);
             
-            for (size_t i = 0; i < flights.size(); i++) {
-                vector<pair<string, int>> row = {
-                    {to_string(i + 1), 10},
-                    {flights[i].getFlightID(), 15},
-                    {flights[i].getAirlineName(), 25},
-                    {flights[i].getDestination(), 25}
-                };
-                
-                printTableRow(row);
+            vector<string> flightIDs;
+            {
+                shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+                for (size_t i = 0; i < flights.size(); i++) {
+                    vector<pair<string, int>> row = {
+                        {to_string(i + 1), 10},
+                        {flights[i].getFlightID(), 15},
+                        {flights[i].getAirlineName(), 25},
+                        {flights[i].getDestination(), 25}
+                    };
+                    
+                    printTableRow(row);
+                    flightIDs.push_back(flights[i].getFlightID());
+                }
             }
             
             printBackOption();
 
-            int flightIndex = getValidIntegerInput("\nEnter flight number to view status:", 0, flights.size());
+            int flightIndex = getValidIntegerInput("\nEnter flight number to view status:", 0, flightIDs.size());
 
             if(flightIndex == 0){
                 return;
             }
             
-            Flight& flight = flights[flightIndex - 1];
+            string flightID = flightIDs[flightIndex - 1];
+            string currentAirline, currentDeparture, currentArrival, currentStatus;
+            int64_t departureAt = unknownScheduleTime;
+            int64_t arrivalAt = unknownScheduleTime;
+            
+            {
+                shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+                Flight* flight = FlightRegistry::find(flightID);
+                if (flight == nullptr) {
+                    throw ValidationException("Flight not found: " + flightID);
+                }
+                
+                currentAirline = flight->getAirlineName();
+                currentDeparture = flight->getDepartureTime();
+                currentArrival = flight->getArrivalTime();
+                currentStatus = flight->getStatus();
+                departureAt = flight->getDepartureAt();
+                arrivalAt = flight->getArrivalAt();
+            }
             
             clearScreen();
             printHeader("FLIGHT STATUS");
             
-            cout << "  Flight Number: " << flight.getFlightID() << "\n";
-            cout << "  Airline: " << flight.getAirlineName() << "\n";
-            cout << "  Departure Time: " << flight.getDepartureTime() << "\n";
-            cout << "  Arrival Time: " << flight.getArrivalTime() << "\n";
-            cout << "  Status: " << flight.getStatus() << "\n";
+            cout << "  Flight Number: " << flightID << "\n";
+            cout << "  Airline: " << currentAirline << "\n";
+            cout << "  Departure Time: " << currentDeparture << "\n";
+            cout << "  Arrival Time: " << currentArrival << "\n";
+            cout << "  Status: " << currentStatus << "\n";
             
             char editOption = getYesNoInput("\nDo you want to edit the flight? (y/n):");
 
@@ -1867,9 +5895,9 @@ public:
                 string airline, departureTime, arrivalTime, status;
                 
                 do {
-                    printPrompt("\nEnter Airline (current: " + flight.getAirlineName() + "):");
+                    printPrompt("\nEnter Airline (current: " + currentAirline + "):");
                     getline(cin, airline);
-                    if (airline.empty()) airline = flight.getAirlineName();
+                    if (airline.empty()) airline = currentAirline;
                     if (isOnlySpaces(airline)) {
                         printErrorMessage("Airline name cannot contain only spaces. Please try again.");
                         airline.clear();
@@ -1877,29 +5905,38 @@ public:
                 } while (airline.empty());
                 
                 do {
-                    printPrompt("Enter Departure Time (current: " + flight.getDepartureTime() + "):");
+                    printPrompt("Enter Departure Time (current: " + currentDeparture + "):");
                     getline(cin, departureTime);
-                    if (departureTime.empty()) departureTime = flight.getDepartureTime();
+                    if (departureTime.empty()) departureTime = currentDeparture;
                     if (isOnlySpaces(departureTime)) {
                         printErrorMessage("Departure time cannot contain only spaces. Please try again.");
                         departureTime.clear();
+                    } else if (!parseScheduleTime(departureTime, departureAt)) {
+                        printErrorMessage("Invalid departure time. Use the format May 10, 2025 - 08:00 AM.");
+                        departureTime.clear();
                     }
                 } while (departureTime.empty());
                 
                 do {
-                    printPrompt("Enter Arrival Time (current: " + flight.getArrivalTime() + "):");
+                    printPrompt("Enter Arrival Time (current: " + currentArrival + "):");
                     getline(cin, arrivalTime);
-                    if (arrivalTime.empty()) arrivalTime = flight.getArrivalTime();
+                    if (arrivalTime.empty()) arrivalTime = currentArrival;
                     if (isOnlySpaces(arrivalTime)) {
                         printErrorMessage("Arrival time cannot contain only spaces. Please try again.");
                         arrivalTime.clear();
+                    } else if (!parseScheduleTime(arrivalTime, arrivalAt)) {
+                        printErrorMessage("Invalid arrival time. Use the format May 10, 2025 - 09:30 AM.");
+                        arrivalTime.clear();
+                    } else if (arrivalAt <= departureAt) {
+                        printErrorMessage("Arrival time must be after the departure time. Please try again.");
+                        arrivalTime.clear();
                     }
                 } while (arrivalTime.empty());
                 
                 do {
-                    printPrompt("Enter Flight Status (current: " + flight.getStatus() + "):");
+                    printPrompt("Enter Flight Status (current: " + currentStatus + "):");
                     getline(cin, status);
-                    if (status.empty()) status = flight.getStatus();
+                    if (status.empty()) status = currentStatus;
                     if (isOnlySpaces(status)) {
                         printErrorMessage("Flight status cannot contain only spaces. Please try again.");
                         status.clear();
@@ -1908,17 +5945,12 @@ public:
                 
                 char confirm = getYesNoInput("\nConfirm changes? (y/n):");
                 
-                if (confirm == 'y') {
-                    flight.setAirlineName(airline);
-                    flight.setDepartureTime(departureTime);
-                    flight.setArrivalTime(arrivalTime);
-                    flight.setStatus(status);
-                    
-                    Flight::saveAllFlights();
-                    
+                if (confirm != 'y') {
+                    printInfoMessage("Changes cancelled.");
+                } else if (BookingService::updateFlight(flightID, airline, departureAt, arrivalAt, status)) {
                     printSuccessMessage("Flight information updated successfully!");
                 } else {
-                    printInfoMessage("Changes cancelled.");
+                    printErrorMessage("Flight " + flightID + " no longer exists.");
                 }
             }
         } catch (const exception& e) {
@@ -1950,29 +5982,36 @@ public:
             
             printTableHeader(columns);
             
-            for (size_t i = 0; i < flights.size(); i++) {
-                vector<pair<string, int>> row = {
-                    {to_string(i + 1), 10},
-                    {flights[i].getFlightID(), 15},
-                    {flights[i].getAirlineName(), 25},
-                    {flights[i].getDestination(), 25}
-                };
-                
-                printTableRow(row);
+            vector<string> flightIDs;
+            {
+                shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+                for (size_t i = 0; i < flights.size(); i++) {
+                    vector<pair<string, int>> row = {
+                        {to_string(i + 1), 10},
+                        {flights[i].getFlightID(), 15},
+                        {flights[i].getAirlineName(), 25},
+                        {flights[i].getDestination(), 25}
+                    };
+                    
+                    printTableRow(row);
+                    flightIDs.push_back(flights[i].getFlightID());
+                }
             }
             
             printBackOption();
 
-            int flightIndex = getValidIntegerInput("\nEnter flight number to view seat map:", 0, flights.size());
+            int flightIndex = getValidIntegerInput("\nEnter flight number to view seat map:", 0, flightIDs.size());
 
             if(flightIndex == 0){
                 return;
             }
             
-            Flight& flight = flights[flightIndex - 1];
-            
             clearScreen();
-            flight.displaySeatMap();
+            if (!BookingService::inspectFlight(flightIDs[flightIndex - 1], [](const Flight& flight) {
+                flight.displaySeatMap();
+            })) {
+                throw ValidationException("Flight not found: " + flightIDs[flightIndex - 1]);
+            }
         } catch (const exception& e) {
             printErrorMessage(e.what());
         }
@@ -2002,33 +6041,32 @@ public:
             
             printTableHeader(columns);
             
-            for (size_t i = 0; i < flights.size(); i++) {
-                vector<pair<string, int>> row = {
-                    {to_string(i + 1), 10},
-                    {flights[i].getFlightID(), 15},
-                    {flights[i].getAirlineName(), 25},
-                    {flights[i].getDestination(), 25}
-                };
-                
-                printTableRow(row);
+            vector<string> flightIDs;
+            {
+                shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+                for (size_t i = 0; i < flights.size(); i++) {
+                    vector<pair<string, int>> row = {
+                        {to_string(i + 1), 10},
+                        {flights[i].getFlightID(), 15},
+                        {flights[i].getAirlineName(), 25},
+                        {flights[i].getDestination(), 25}
+                    };
+                    
+                    printTableRow(row);
+                    flightIDs.push_back(flights[i].getFlightID());
+                }
             }
             
             printBackOption();
 
-            int flightIndex = getValidIntegerInput("\nEnter flight number to manage waiting list:", 0, flights.size());
+            int flightIndex = getValidIntegerInput("\nEnter flight number to manage waiting list:", 0, flightIDs.size());
 
             if(flightIndex == 0){
                 return;
             }
             
-            Flight& flight = flights[flightIndex - 1];
-            string flightID = flight.getFlightID();
-            
-            if (waitingLists.find(flightID) == waitingLists.end()) {
-                waitingLists[flightID] = WaitingList(flightID);
-            }
-            
-            WaitingList& waitingList = waitingLists[flightID];
+            string flightID = flightIDs[flightIndex - 1];
+            WaitingList waitingList = BookingService::waitingListFor(flightID);
             
             clearScreen();
             waitingList.display();
@@ -2047,7 +6085,14 @@ public:
             
             switch (choice) {
                 case 1: {
-                    if (flight.isFullyBooked()) {
+                    bool fullyBooked = false;
+                    bool found = BookingService::inspectFlight(flightID, [&fullyBooked](const Flight& flight) {
+                        fullyBooked = flight.isFullyBooked();
+                    });
+                    if (!found) {
+                        throw ValidationException("Flight not found: " + flightID);
+                    }
+                    if (fullyBooked) {
                         throw BookingException("Flight is fully booked. Cannot promote passenger.");
                     }
                     
@@ -2056,7 +6101,7 @@ public:
                         throw ValidationException("No passengers in the waiting list");
                     }
                     
-                    flight.displaySeatMap();
+                    BookingService::inspectFlight(flightID, [](const Flight& flight) { flight.displaySeatMap(); });
                     
                     string seatNumber;
                     bool validSeatNumber = false;
@@ -2065,10 +6110,17 @@ public:
                         printPrompt("\nEnter seat number for the passenger:");
                         getline(cin, seatNumber);
                         
+                        bool available = false;
+                        if (!seatNumber.empty()) {
+                            BookingService::inspectFlight(flightID, [&](const Flight& flight) {
+                                available = flight.isSeatAvailable(seatNumber);
+                            });
+                        }
+                        
                         if (seatNumber.empty()) {
                             printErrorMessage("Seat number cannot be empty. Please try again.");
                             continue;
-                        } else if (!flight.isSeatAvailable(seatNumber)) {
+                        } else if (!available) {
                             printErrorMessage("Seat is not available. Please choose another seat.");
                             continue;
                         }
@@ -2078,22 +6130,13 @@ public:
                     
                     char confirm = getYesNoInput("\nConfirm changes? (y/n):");
                     
-                    if (confirm == 'y') {
-                        flight.bookSeat(seatNumber);
-                        
-                        Reservation reservation(nextPassenger.second, flightID, flight.getAirlineName(), 
-                                               flight.getDestination(), seatNumber, nextPassenger.first);
-                        reservations.push_back(reservation);
-                        
-                        waitingList.removePassenger(nextPassenger.first);
-                        
-                        Flight::saveAllFlights();
-                        Reservation::saveAllReservations();
-                        waitingList.saveToFile();
-                        
+                    if (confirm != 'y') {
+                        printInfoMessage("Promotion cancelled.");
+                    } else if (BookingService::promoteWaitlisted(flightID, seatNumber)) {
                         printSuccessMessage("Passenger promoted successfully!");
                     } else {
-                        printInfoMessage("Promotion cancelled.");
+                        throw BookingException("Seat " + seatNumber + " was taken or the waiting list changed. "
+                                               "No passenger was promoted.");
                     }
                     break;
                 }
@@ -2107,11 +6150,10 @@ public:
 
                         if (username.empty()) {
                             printErrorMessage("Username cannot be empty. Please try again.");
-                        } else if (!waitingList.removePassenger(username)) {
+                        } else if (!BookingService::leaveWaitingList(flightID, username)) {
                             printErrorMessage("Passenger not found in the waiting list. Please try again.");
                         } else {
                             validUsername = true;
-                            waitingList.saveToFile();
                             printSuccessMessage("Passenger removed from the waiting list successfully!");
                         }
                     }
@@ -2135,7 +6177,7 @@ public:
             printSubHeader("Customer Accounts");
             
             vector<User*> customers;
-            for (auto& user : users) {
+            for (auto& user : UserDirectory::all()) {
                 if (!user->getIsAdmin()) {
                     customers.push_back(user);
                 }
@@ -2176,12 +6218,9 @@ public:
                     if (username.empty()) {
                         printErrorMessage("Username cannot be empty. Please try again.");
                     } else {
-                        auto it = find_if(users.begin(), users.end(),
-                                         [&username](const User* u) { 
-                                             return u->getUsername() == username && !u->getIsAdmin(); 
-                                         });
+                        User* account = UserDirectory::find(username);
                     
-                        if (it == users.end()) {
+                        if (account == nullptr || account->getIsAdmin()) {
                             printErrorMessage("Customer account not found. Please try again.");
                         } else {
                             validUsername = true;
@@ -2189,25 +6228,7 @@ public:
                             char confirm = getYesNoInput("\nConfirm delete (y/n):");
                         
                             if (confirm == 'y') {
-                                string actualUsername = (*it)->getUsername();
-                            
-                                reservations.erase(
-                                    remove_if(reservations.begin(), reservations.end(),
-                                             [&actualUsername](const Reservation& r) { 
-                                                 return r.getUsername() == actualUsername; 
-                                             }),
-                                    reservations.end());
-                            
-                                for (auto& pair : waitingLists) {
-                                    pair.second.removePassenger(actualUsername);
-                                }
-                            
-                                delete *it;
-                                users.erase(it);
-                            
-                                User::saveAllUsers();
-                                Reservation::saveAllReservations();
-                                WaitingList::saveAllWaitingLists();
+                                BookingService::deleteUser(account->getUsername());
                             
                                 printSuccessMessage("User account deleted successfully!");
                             } else {
@@ -2240,8 +6261,8 @@ public:
             clearScreen();
             printHeader("CUSTOMER DASHBOARD");
             
-            cout << "  Welcome, " << getName() << "!" << endl;
-            cout << "  " << getCurrentDateTime() << endl;
+            cout << "  Welcome, " << getName() << "!\n";
+            cout << "  " << getCurrentDateTime() << "\n";
             
             printSeparator();
             
@@ -2266,6 +6287,8 @@ public:
                     printInfoMessage("Logging out...");
                     break;
             }
+            
+            BookingService::compactIfDue();
         } while (choice != 4);
     }
 
@@ -2293,17 +6316,20 @@ public:
             
             printTableHeader(columns);
             
-            for (const auto& flight : flights) {
-                vector<pair<string, int>> row = {
-                    {flight.getFlightID(), 15},
-                    {flight.getAirlineName(), 20},
-                    {flight.getDestination(), 25},
-                    {flight.getDepartureTime(), 30},
-                    {flight.getArrivalTime(), 35},
-                    {to_string(flight.getAvailableSeats()), 15}
-                };
-                
-                printTableRow(row);
+            {
+                shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+                for (const auto& flight : flights) {
+                    vector<pair<string, int>> row = {
+                        {flight.getFlightID(), 15},
+                        {flight.getAirlineName(), 20},
+                        {flight.getDestination(), 25},
+                        {flight.getDepartureTime(), 30},
+                        {flight.getArrivalTime(), 35},
+                        {to_string(flight.getAvailableSeats()), 15}
+                    };
+                    
+                    printTableRow(row);
+                }
             }
             
             char bookOption = getYesNoInput("\nDo you want to book a flight? (y/n): ");
@@ -2349,21 +6375,8 @@ public:
 
             clearScreen();
             
-            vector<Flight*> matchingFlights;
-            
-            for (auto& flight : flights) {
-                string flightDest = flight.getDestination();
-                size_t toPos = toLower(flightDest).find(" to ");
-                
-                if (toPos != string::npos) {
-                    string actualDestination = flightDest.substr(toPos + 4);
-                    if (containsIgnoreCase(actualDestination, destination)) {
-                        matchingFlights.push_back(&flight);
-                    }
-                } else if (containsIgnoreCase(flightDest, destination)) {
-                    matchingFlights.push_back(&flight);
-                }
-            }
+            shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+            vector<Flight*> matchingFlights = DestinationIndex::search(destination);
             
             if (matchingFlights.empty()) {
                 throw ValidationException("No flights found for destination: " + destination);
@@ -2382,6 +6395,7 @@ public:
             
             printTableHeader(columns);
             
+            vector<string> flightIDs;
             for (size_t i = 0; i < matchingFlights.size(); i++) {
                 vector<pair<string, int>> row = {
                     {to_string(i + 1), 5},
@@ -2393,40 +6407,56 @@ public:
                 };
                 
                 printTableRow(row);
+                flightIDs.push_back(matchingFlights[i]->getFlightID());
             }
+            catalogGuard.unlock();
             
             printBackOption();
 
-            int flightIndex = getValidIntegerInput("\nChoose flight. Enter flight number:", 0, matchingFlights.size());
+            int flightIndex = getValidIntegerInput("\nChoose flight. Enter flight number:", 0, flightIDs.size());
 
             if(flightIndex == 0){
                 return;
             }
             
-            Flight* selectedFlight = matchingFlights[flightIndex - 1];
+            string flightID = flightIDs[flightIndex - 1];
+            string airlineName, flightDestination;
+            int64_t departureAt = unknownScheduleTime;
+            bool fullyBooked = false;
+            
+            bool found = BookingService::inspectFlight(flightID, [&](const Flight& flight) {
+                airlineName = flight.getAirlineName();
+                flightDestination = flight.getDestination();
+                departureAt = flight.getDepartureAt();
+                fullyBooked = flight.isFullyBooked();
+                if (!fullyBooked) {
+                    flight.displaySeatMap();
+                }
+            });
+            if (!found) {
+                throw ValidationException("Flight is no longer available.");
+            }
             
-            if (selectedFlight->isFullyBooked()) {
+            if (fullyBooked) {
                 printWarningMessage("This flight is fully booked.");
                 
                 char waitingListOption = getYesNoInput("Do you want to be added to the waiting list? (y/n):");
                 
                 if (waitingListOption == 'y') {
-                    if (waitingLists.find(selectedFlight->getFlightID()) == waitingLists.end()) {
-                        waitingLists[selectedFlight->getFlightID()] = WaitingList(selectedFlight->getFlightID());
+                    WaitlistResult result = BookingService::joinWaitingList(flightID, getUsername(), getName());
+                    if (result == WaitlistResult::Queued) {
+                        printSuccessMessage("You have been added to the waiting list for this flight.");
+                    } else if (result == WaitlistResult::AlreadyQueued) {
+                        printWarningMessage("You are already on the waiting list for this flight.");
+                    } else {
+                        printErrorMessage("Flight is no longer available.");
                     }
-                    
-                    waitingLists[selectedFlight->getFlightID()].addPassenger(getUsername(), getName());
-                    waitingLists[selectedFlight->getFlightID()].saveToFile();
-                    
-                    printSuccessMessage("You have been added to the waiting list for this flight.");
                 }
                 
                 pressEnterToContinue();
                 return;
             }
             
-            selectedFlight->displaySeatMap();
-            
             string seatNumber;
             bool validSeatNumber = false;
             
@@ -2439,7 +6469,15 @@ public:
                 } else if (seatNumber.empty()) {
                     printErrorMessage("Seat number cannot be empty. Please try again.");
                     continue;
-                } else if (!selectedFlight->isSeatAvailable(seatNumber)) {
+                }
+                
+                bool available = false;
+                if (!BookingService::inspectFlight(flightID, [&](const Flight& flight) {
+                    available = flight.isSeatAvailable(seatNumber);
+                })) {
+                    throw ValidationException("Flight is no longer available.");
+                }
+                if (!available) {
                     printErrorMessage("Seat is not available. Please choose another seat.");
                     continue;
                 }
@@ -2552,263 +6590,1048 @@ public:
             clearScreen();
             printSubHeader("Payment Summary");
             
-            cout << "  Flight: " << selectedFlight->getFlightID() << " - " << selectedFlight->getAirlineName() << endl;
-            cout << "  Destination: " << selectedFlight->getDestination() << endl;
-            cout << "  Seat: " << seatNumber << endl;
-            cout << "  Payment Method: " << paymentDetails << endl;
-            cout << "  Amount: ₱" << fixed << setprecision(2) << flightPrice << endl;
+            cout << "  Flight: " << flightID << " - " << airlineName << "\n";
+            cout << "  Destination: " << flightDestination << "\n";
+            cout << "  Seat: " << seatNumber << "\n";
+            cout << "  Payment Method: " << paymentDetails << "\n";
+            cout << "  Amount: ₱" << fixed << setprecision(2) << flightPrice << "\n";
             
             char confirm = getYesNoInput("\nConfirm payment? (y/n):");
             
-            bool paymentConfirmed = false;
-            if (confirm == 'y') {
-                paymentConfirmed = paymentStrategy->processPayment(flightPrice);
+            bool paymentConfirmed = false;
+            if (confirm == 'y') {
+                paymentConfirmed = paymentStrategy->processPayment(flightPrice);
+            }
+            
+            if (paymentConfirmed) {
+                Reservation reservation;
+                SeatResult result = BookingService::book(flightID, seatNumber, getUsername(),
+                                                         getName(), paymentDetails, reservation);
+                if (result != SeatResult::Ok) {
+                    throw BookingException(seatResultMessage(result, seatNumber));
+                }
+                
+                printSuccessMessage("Payment successful! Your flight has been booked.");
+                
+                clearScreen();
+                printHeader("BOARDING PASS");
+
+                const int fixedWidth = 70;
+
+                string border = "  +-" + string(fixedWidth, '-') + "-+\n";
+                vector<pair<string, int>> blank = {{"  | ", 0}, {" ", fixedWidth}, {" |", 0}};
+                vector<vector<pair<string, int>>> lines = {
+                    blank,
+                    {{"  | ", 0}, {"   " + airlineName + " Airlines", fixedWidth}, {" |", 0}},
+                    blank,
+                    {{"  |  PASSENGER: ", 0}, {getName(), fixedWidth - 12}, {" |", 0}},
+                    blank,
+                    {{"  |  FLIGHT: ", 0}, {flightID, 15}, {"DATE: ", 0},
+                     {string(ScheduleClock::date(departureAt)), fixedWidth - 30}, {" |", 0}},
+                    blank,
+                    {{"  |  FROM/TO: ", 0}, {flightDestination, fixedWidth - 10}, {" |", 0}},
+                    blank,
+                    {{"  |  SEAT: ", 0}, {seatNumber, fixedWidth - 7}, {" |", 0}},
+                    blank,
+                    {{"  |  BOARDING TIME: ", 0}, {string(ScheduleClock::clock(departureAt)), fixedWidth - 16}, {" |", 0}},
+                    blank,
+                    {{"  |  ", 0}, {"Thank you for choosing " + airlineName + "!", fixedWidth - 1}, {" |", 0}},
+                    blank
+                };
+                
+                string boardingPass = border;
+                for (const auto& cells : lines) {
+                    appendCells(boardingPass, cells);
+                }
+                boardingPass += border;
+                cout.write(boardingPass.data(), boardingPass.size());
+                
+            } else {
+                printInfoMessage("Payment cancelled. Booking not completed.");
+            }
+        } catch (const exception& e) {
+            printErrorMessage(e.what());
+        }
+        
+        pressEnterToContinue();
+    }
+
+    void viewBooking() {
+        clearScreen();
+        printHeader("VIEW BOOKING");
+        
+        try {
+            vector<Reservation> customerReservations = BookingService::reservationsFor(getUsername());
+            vector<Reservation> archivedReservations = BookingService::archivedReservationsFor(getUsername());
+            customerReservations.insert(customerReservations.end(), archivedReservations.begin(),
+                                        archivedReservations.end());
+            
+            if (customerReservations.empty()) {
+                printInfoMessage("You have no bookings.");
+                pressEnterToContinue();
+                return;
+            }
+            
+            printSubHeader("Your Bookings");
+            
+            vector<pair<string, int>> columns = {
+                {"Reservation ID", 20},
+                {"Flight ID", 17},
+                {"Airline", 26},
+                {"Destination", 25},
+                {"Seat Number", 20},
+                {"Status", 15}
+            };
+            
+            printTableHeader(columns);
+            
+            for (const auto& reservation : customerReservations) {
+                vector<pair<string, int>> row = {
+                    {reservation.getReservationID(), 21},
+                    {reservation.getFlightID(), 16},
+                    {reservation.getAirlineName(), 25},
+                    {reservation.getDestination(), 30},
+                    {reservation.getSeatNumber(), 15},
+                    {reservation.getStatus(), 15}
+                };
+                
+                printTableRow(row);
+            }
+        } catch (const exception& e) {
+            printErrorMessage(e.what());
+        }
+        
+        pressEnterToContinue();
+    }
+
+    void cancelBooking() {
+        clearScreen();
+        printHeader("CANCEL BOOKING");
+        
+        try {
+            vector<Reservation> customerReservations = BookingService::reservationsFor(getUsername());
+            
+            if (customerReservations.empty()) {
+                printInfoMessage("You have no bookings to cancel.");
+                pressEnterToContinue();
+                return;
+            }
+            
+            printSubHeader("Your Bookings");
+            
+            vector<pair<string, int>> columns = {
+                {"No.", 5},
+                {"Reservation ID", 20},
+                {"Flight ID", 15},
+                {"Airline", 25},
+                {"Destination", 26.5},
+                {"Seat Number", 15}
+            };
+            
+            printTableHeader(columns);
+            
+            for (size_t i = 0; i < customerReservations.size(); i++) {
+                vector<pair<string, int>> row = {
+                    {to_string(i + 1), 5},
+                    {customerReservations[i].getReservationID(), 21},
+                    {customerReservations[i].getFlightID(), 15},
+                    {customerReservations[i].getAirlineName(), 25},
+                    {customerReservations[i].getDestination(), 30},
+                    {customerReservations[i].getSeatNumber(), 15}
+                };
+                
+                printTableRow(row);
+            }
+            
+            printBackOption();
+            
+            int bookingIndex = getValidIntegerInput("\nEnter booking number to cancel:", 0, customerReservations.size());
+
+            if(bookingIndex == 0){
+                return;
+            }
+            
+            Reservation& selectedReservation = customerReservations[bookingIndex - 1];
+            
+            clearScreen();
+            printSubHeader("Cancellation Confirmation");
+            
+            cout << "  Reservation ID: " << selectedReservation.getReservationID() << "\n";
+            cout << "  Flight: " << selectedReservation.getFlightID() << " - " << selectedReservation.getAirlineName() << "\n";
+            cout << "  Destination: " << selectedReservation.getDestination() << "\n";
+            cout << "  Seat: " << selectedReservation.getSeatNumber() << "\n";
+            
+            char confirm = getYesNoInput("\nConfirm cancellation? (y/n):");
+            
+            if (confirm == 'y') {
+                if (!BookingService::cancel(getUsername(), selectedReservation.getReservationID())) {
+                    throw BookingException("Booking " + selectedReservation.getReservationID() + " no longer exists");
+                }
+                
+                printSuccessMessage("Booking has been successfully cancelled.");
+            } else {
+                printInfoMessage("Cancellation cancelled.");
+            }
+        } catch (const exception& e) {
+            printErrorMessage(e.what());
+        }
+        
+        pressEnterToContinue();
+    }
+};
+
+vector<unique_ptr<User>> User::readUsers(bool& upgraded) {
+    size_t chunkCount = WorkerPool::concurrency();
+    vector<vector<unique_ptr<User>>> parsed(chunkCount);
+    vector<char> rehashed(chunkCount, 0);
+    
+    DatabaseManager* dbManager = DatabaseManager::getInstance();
+    dbManager->forEachRecordParallel("users.txt", chunkCount, [&](size_t chunk, const CsvRecord& record) {
+        if (record.size() >= 4) {
+            string username = record.str(0);
+            string password = record.str(1);
+            string name = record.str(2);
+            bool isAdmin = (record[3] == "admin");
+            
+            if (!PasswordHasher::isHashed(password)) {
+                password = PasswordHasher::hash(password);
+                rehashed[chunk] = 1;
+            }
+            
+            if (isAdmin) {
+                parsed[chunk].push_back(make_unique<Admin>(username, password, name));
+            } else {
+                parsed[chunk].push_back(make_unique<Customer>(username, password, name));
+            }
+        }
+    });
+    
+    upgraded = upgraded || find(rehashed.begin(), rehashed.end(), 1) != rehashed.end();
+    return concatenateChunks(parsed);
+}
+
+void User::publishUsers(vector<unique_ptr<User>>& loaded, bool upgraded) {
+    UserDirectory::clear();
+    for (auto& user : loaded) {
+        UserDirectory::add(std::move(user));
+    }
+    loaded.clear();
+    
+    if (upgraded) {
+        saveAllUsers();
+    }
+}
+
+void User::loadUsers() {
+    try {
+        bool upgraded = false;
+        vector<unique_ptr<User>> loaded = readUsers(upgraded);
+        publishUsers(loaded, upgraded);
+    } catch (const exception& e) {
+        printErrorMessage("Error loading users: " + string(e.what()));
+    }
+}
+
+void IdSequence::seed() {
+    DatabaseManager::getInstance()->forEachRecord("sequences.txt", [](const CsvRecord& record) {
+        int value;
+        if (record.size() >= 2 && parseInt(record[1], value)) {
+            observe(record.str(0), value);
+        }
+    });
+    
+    for (const auto& flight : flights) {
+        observeID("FL", flight.getFlightID());
+    }
+    for (const auto& reservation : reservations) {
+        observeID("RES", reservation.getReservationID());
+    }
+}
+
+void IdSequence::save() {
+    string data;
+    {
+        shared_lock<shared_mutex> guard(countersMutex);
+        for (const auto& entry : counters) {
+            data += entry.first + "," + to_string(entry.second->load()) + "\n";
+        }
+    }
+    
+    if (!data.empty()) {
+        DatabaseManager::getInstance()->writeAtomically("sequences.txt", data);
+    }
+}
+
+class Snapshot {
+private:
+    static constexpr uint32_t formatVersion = 3;
+    static constexpr uint32_t byteOrderMark = 0x01020304;
+    static constexpr uint32_t endMarker = 0x454E4421;
+
+    static unique_ptr<MappedFile> mapped;
+
+    class Writer {
+    private:
+        string buffer;
+
+    public:
+        void bytes(const void* data, size_t length) {
+            buffer.append(static_cast<const char*>(data), length);
+        }
+
+        void u32(uint32_t value) { bytes(&value, sizeof(value)); }
+        void i32(int32_t value) { bytes(&value, sizeof(value)); }
+        void i64(int64_t value) { bytes(&value, sizeof(value)); }
+
+        void str(const string& value) {
+            u32(static_cast<uint32_t>(value.size()));
+            bytes(value.data(), value.size());
+        }
+
+        void align8() {
+            while (buffer.size() % 8 != 0) {
+                buffer += '\0';
+            }
+        }
+
+        string take() { return std::move(buffer); }
+    };
+
+    class Reader {
+    private:
+        const unsigned char* data;
+        size_t length;
+        size_t position;
+
+    public:
+        Reader(const unsigned char* data, size_t length) : data(data), length(length), position(0) {}
+
+        const unsigned char* bytes(size_t count) {
+            if (count > length - position) {
+                throw FileOperationException("Snapshot is truncated");
+            }
+            const unsigned char* start = data + position;
+            position += count;
+            return start;
+        }
+
+        uint32_t u32() {
+            uint32_t value;
+            memcpy(&value, bytes(sizeof(value)), sizeof(value));
+            return value;
+        }
+
+        int32_t i32() {
+            int32_t value;
+            memcpy(&value, bytes(sizeof(value)), sizeof(value));
+            return value;
+        }
+
+        int64_t i64() {
+            int64_t value;
+            memcpy(&value, bytes(sizeof(value)), sizeof(value));
+            return value;
+        }
+
+        string str() {
+            return string(view());
+        }
+
+        string_view view() {
+            uint32_t size = u32();
+            return string_view(reinterpret_cast<const char*>(bytes(size)), size);
+        }
+
+        void align8() {
+            bytes((8 - position % 8) % 8);
+        }
+
+        size_t offset() const { return position; }
+    };
+
+    static size_t seatBytes(int rows, const SeatLayoutInfo& layout) {
+        return ((static_cast<size_t>(rows) * layout.seatColumns + 63) / 64) * sizeof(uint64_t);
+    }
+
+public:
+    static bool load() {
+        unique_ptr<MappedFile> file = make_unique<MappedFile>();
+        if (!file->open("snapshot.bin")) {
+            return false;
+        }
+        
+        vector<Flight> loadedFlights;
+        vector<Reservation> loadedReservations;
+        vector<unique_ptr<User>> loadedUsers;
+        map<string, WaitingList> loadedWaitingLists;
+        int64_t generation = 0;
+        
+        try {
+            Reader reader(file->data(), file->size());
+            
+            if (memcmp(reader.bytes(8), "ARSNAP\0\0", 8) != 0) {
+                return false;
             }
+            uint32_t version = reader.u32();
+            if ((version != formatVersion && version != 2) || reader.u32() != byteOrderMark) {
+                return false;
+            }
+            generation = version == formatVersion ? reader.i64() : 0;
             
-            if (paymentConfirmed) {
-                selectedFlight->bookSeat(seatNumber);
+            uint32_t flightCount = reader.u32();
+            loadedFlights.reserve(flightCount);
+            for (uint32_t i = 0; i < flightCount; i++) {
+                Flight flight;
+                flight.flightID = reader.str();
+                flight.airlineName = reader.view();
+                flight.planeID = reader.str();
+                flight.destination = reader.view();
+                flight.departureAt = reader.i64();
+                flight.arrivalAt = reader.i64();
+                flight.status = reader.view();
+                flight.capacity = reader.i32();
+                flight.availableSeats = reader.i32();
+                flight.calculateSeatLayout();
                 
-                Reservation reservation(getName(), selectedFlight->getFlightID(), selectedFlight->getAirlineName(), 
-                                       selectedFlight->getDestination(), seatNumber, getUsername(), paymentDetails);
-                reservations.push_back(reservation);
+                flight.snapshotSeatRows = reader.i32();
+                reader.align8();
+                flight.snapshotSeats = reader.bytes(seatBytes(flight.snapshotSeatRows, *flight.layout));
                 
-                Flight::saveAllFlights();
-                reservation.saveToFile();
+                loadedFlights.push_back(flight);
+            }
+            
+            uint32_t reservationCount = reader.u32();
+            loadedReservations.reserve(reservationCount);
+            for (uint32_t i = 0; i < reservationCount; i++) {
+                vector<string_view> fields(9);
+                for (auto& field : fields) {
+                    field = reader.view();
+                }
                 
-                printSuccessMessage("Payment successful! Your flight has been booked.");
+                Reservation reservation;
+                Reservation::fromTokens(fields, reservation);
+                loadedReservations.push_back(reservation);
+            }
+            
+            uint32_t userCount = reader.u32();
+            for (uint32_t i = 0; i < userCount; i++) {
+                string username = reader.str();
+                string password = reader.str();
+                string name = reader.str();
                 
-                clearScreen();
-                printHeader("BOARDING PASS");
-
-                const int fixedWidth = 70;
-
-                cout << "  +-" << string(fixedWidth, '-') << "-+" << endl;
-                cout << "  | " << setw(fixedWidth) << left << " " << " |" << endl;
-                cout << "  | " << setw(fixedWidth) << left << "   " + selectedFlight->getAirlineName() + " Airlines" << " |" << endl;
-                cout << "  | " << setw(fixedWidth) << left << " " << " |" << endl;
-                cout << "  |  PASSENGER: " << setw(fixedWidth - 12) << left << getName() << " |" << endl;
-                cout << "  | " << setw(fixedWidth) << left << " " << " |" << endl;
-                cout << "  |  FLIGHT: " << setw(15) << left << selectedFlight->getFlightID() 
-                     << "DATE: " << setw(fixedWidth - 30) << left << selectedFlight->getDepartureTime().substr(0, selectedFlight->getDepartureTime().find(" - ")) << " |" << endl;
-                cout << "  | " << setw(fixedWidth) << left << " " << " |" << endl;
-                cout << "  |  FROM/TO: " << setw(fixedWidth - 10) << left << selectedFlight->getDestination() << " |" << endl;
-                cout << "  | " << setw(fixedWidth) << left << " " << " |" << endl;
-                cout << "  |  SEAT: " << setw(fixedWidth - 7) << left << seatNumber << " |" << endl;
-                cout << "  | " << setw(fixedWidth) << left << " " << " |" << endl;
-                cout << "  |  BOARDING TIME: " << setw(fixedWidth - 16) << left << selectedFlight->getDepartureTime().substr(selectedFlight->getDepartureTime().find(" - ") + 3) << " |" << endl;
-                cout << "  | " << setw(fixedWidth) << left << " " << " |" << endl;
-                cout << "  |  " << setw(fixedWidth - 1) << left << "Thank you for choosing " + selectedFlight->getAirlineName() + "!" << " |" << endl;
-                cout << "  | " << setw(fixedWidth) << left << " " << " |" << endl;
-                cout << "  +-" << string(fixedWidth, '-') << "-+" << endl;
+                if (reader.u32() != 0) {
+                    loadedUsers.push_back(make_unique<Admin>(username, password, name));
+                } else {
+                    loadedUsers.push_back(make_unique<Customer>(username, password, name));
+                }
+            }
+            
+            uint32_t waitingListCount = reader.u32();
+            for (uint32_t i = 0; i < waitingListCount; i++) {
+                WaitingList waitingList(reader.str());
                 
-            } else {
-                printInfoMessage("Payment cancelled. Booking not completed.");
+                uint32_t passengerCount = reader.u32();
+                for (uint32_t j = 0; j < passengerCount; j++) {
+                    string username = reader.str();
+                    string passengerName = reader.str();
+                    waitingList.addPassenger(username, passengerName);
+                }
+                
+                waitingList.markClean();
+                loadedWaitingLists[waitingList.getFlightID()] = waitingList;
+            }
+            
+            if (reader.u32() != endMarker) {
+                throw FileOperationException("Snapshot end marker missing");
             }
         } catch (const exception& e) {
-            printErrorMessage(e.what());
+            printWarningMessage("Ignoring snapshot.bin: " + string(e.what()));
+            return false;
         }
         
-        pressEnterToContinue();
+        flights.swap(loadedFlights);
+        SeatMapCache::clear();
+        FlightRegistry::rebuild();
+        
+        reservations.swap(loadedReservations);
+        ReservationStore::rebuild();
+        
+        UserDirectory::clear();
+        for (auto& user : loadedUsers) {
+            UserDirectory::add(move(user));
+        }
+        
+        waitingLists.swap(loadedWaitingLists);
+        for (const auto& flight : flights) {
+            if (waitingLists.find(flight.getFlightID()) == waitingLists.end()) {
+                waitingLists[flight.getFlightID()] = WaitingList(flight.getFlightID());
+            }
+        }
+        
+        Journal::getInstance()->setSnapshot(generation, file->size());
+        mapped = std::move(file);
+        return true;
     }
 
-    void viewBooking() {
-        clearScreen();
-        printHeader("VIEW BOOKING");
+    static string capture(int64_t generation) {
+        Writer writer;
+        writer.bytes("ARSNAP\0\0", 8);
+        writer.u32(formatVersion);
+        writer.u32(byteOrderMark);
+        writer.i64(generation);
         
-        try {
-            vector<Reservation> customerReservations;
-            for (const auto& reservation : reservations) {
-                if (reservation.getUsername() == getUsername()) {
-                    customerReservations.push_back(reservation);
-                }
-            }
-            
-            if (customerReservations.empty()) {
-                printInfoMessage("You have no bookings.");
-                pressEnterToContinue();
-                return;
+        writer.u32(static_cast<uint32_t>(flights.size()));
+        for (const auto& flight : flights) {
+            writer.str(flight.flightID);
+            writer.str(flight.airlineName);
+            writer.str(flight.planeID);
+            writer.str(flight.destination);
+            writer.i64(flight.departureAt);
+            writer.i64(flight.arrivalAt);
+            writer.str(flight.status);
+            writer.i32(flight.capacity);
+            writer.i32(flight.availableSeats);
+            
+            if (!flight.seatMapLoaded && flight.snapshotSeats == nullptr) {
+                flight.ensureSeatMap();
             }
             
-            printSubHeader("Your Bookings");
-            
-            vector<pair<string, int>> columns = {
-                {"Reservation ID", 20},
-                {"Flight ID", 17},
-                {"Airline", 26},
-                {"Destination", 25},
-                {"Seat Number", 20},
-                {"Status", 15}
-            };
-            
-            printTableHeader(columns);
+            int rows = flight.seatMapLoaded ? flight.seatMap.getRows() : flight.snapshotSeatRows;
+            writer.i32(rows);
+            writer.align8();
             
-            for (const auto& reservation : customerReservations) {
-                vector<pair<string, int>> row = {
-                    {reservation.getReservationID(), 21},
-                    {reservation.getFlightID(), 16},
-                    {reservation.getAirlineName(), 25},
-                    {reservation.getDestination(), 30},
-                    {reservation.getSeatNumber(), 15},
-                    {reservation.getStatus(), 15}
-                };
-                
-                printTableRow(row);
+            if (flight.seatMapLoaded) {
+                const vector<uint64_t>& words = flight.seatMap.getWords();
+                writer.bytes(words.data(), words.size() * sizeof(uint64_t));
+            } else {
+                writer.bytes(flight.snapshotSeats, seatBytes(rows, *flight.layout));
+            }
+        }
+        
+        writer.u32(static_cast<uint32_t>(reservations.size()));
+        for (const auto& reservation : reservations) {
+            writer.str(reservation.getReservationID());
+            writer.str(reservation.getPassengerName());
+            writer.str(reservation.getFlightID());
+            writer.str(reservation.getAirlineName());
+            writer.str(reservation.getDestination());
+            writer.str(reservation.getSeatNumber());
+            writer.str(reservation.getStatus());
+            writer.str(reservation.getUsername());
+            writer.str(reservation.getPaymentMethod());
+        }
+        
+        writer.u32(static_cast<uint32_t>(UserDirectory::size()));
+        for (const auto& user : UserDirectory::all()) {
+            writer.str(user->getUsername());
+            writer.str(user->getPassword());
+            writer.str(user->getName());
+            writer.u32(user->getIsAdmin() ? 1 : 0);
+        }
+        
+        writer.u32(static_cast<uint32_t>(waitingLists.size()));
+        for (const auto& entry : waitingLists) {
+            writer.str(entry.first);
+            writer.u32(static_cast<uint32_t>(entry.second.getPassengers().size()));
+            for (const auto& passenger : entry.second.getPassengers()) {
+                writer.str(passenger.first);
+                writer.str(passenger.second);
             }
+        }
+        
+        writer.u32(endMarker);
+        return writer.take();
+    }
+
+    static bool store(const string& data) {
+        try {
+            return DatabaseManager::getInstance()->writeAtomically("snapshot.bin", data, true);
         } catch (const exception& e) {
-            printErrorMessage(e.what());
+            printErrorMessage("Error saving snapshot: " + string(e.what()));
+            return false;
+        }
+    }
+};
+
+unique_ptr<MappedFile> Snapshot::mapped;
+
+void Journal::applyRecord(const vector<string>& tokens) {
+    if (tokens.empty()) {
+        return;
+    }
+    
+    const string& op = tokens[0];
+    
+    if ((op == "BOOK" || op == "CANCEL") && tokens.size() >= 3) {
+        Flight* flight = FlightRegistry::find(tokens[1]);
+        if (flight != nullptr) {
+            flight->setSeatOccupied(tokens[2], op == "BOOK");
+        }
+    } else if (op == "UPDATE" && tokens.size() >= 6) {
+        Flight* flight = FlightRegistry::find(tokens[1]);
+        if (flight != nullptr) {
+            flight->setAirlineName(tokens[2]);
+            flight->setDepartureTime(tokens[3]);
+            flight->setArrivalTime(tokens[4]);
+            flight->setStatus(tokens[5]);
+        }
+    } else if (op == "ADDRES") {
+        Reservation reservation;
+        vector<string_view> fields(tokens.begin() + 1, tokens.end());
+        if (!Reservation::fromTokens(fields, reservation)) {
+            return;
         }
         
-        pressEnterToContinue();
+        if (ReservationStore::find(reservation.getReservationID()) == nullptr) {
+            ReservationStore::add(reservation);
+        }
+    } else if (op == "DELRES" && tokens.size() >= 2) {
+        ReservationStore::remove(tokens[1]);
+    } else if ((op == "DELFLIGHT" || op == "ARCHIVE") && tokens.size() >= 2) {
+        BookingService::unlinkFlight(tokens[1]);
+    } else if (op == "DELUSER" && tokens.size() >= 2) {
+        BookingService::unlinkUser(tokens[1]);
+    } else if (op == "UPDUSER" && tokens.size() >= 3) {
+        User* user = UserDirectory::find(tokens[1]);
+        if (user != nullptr) {
+            user->setPassword(tokens[2]);
+        }
+    } else if (op == "ADDFLIGHT") {
+        Flight flight;
+        vector<string_view> fields(tokens.begin() + 1, tokens.end());
+        if (!Flight::fromTokens(fields, flight) || FlightRegistry::find(flight.getFlightID()) != nullptr) {
+            return;
+        }
+        
+        FlightRegistry::add(flight);
+        DestinationIndex::add(flight);
+        if (waitingLists.find(flight.getFlightID()) == waitingLists.end()) {
+            waitingLists[flight.getFlightID()] = WaitingList(flight.getFlightID());
+        }
+    } else if (op == "ADDUSER" && tokens.size() >= 5) {
+        if (User::usernameExists(tokens[1])) {
+            return;
+        }
+        
+        if (tokens[4] == "admin") {
+            UserDirectory::add(make_unique<Admin>(tokens[1], tokens[2], tokens[3]));
+        } else {
+            UserDirectory::add(make_unique<Customer>(tokens[1], tokens[2], tokens[3]));
+        }
+    } else if (op == "WAITLIST" && tokens.size() >= 2) {
+        WaitingList waitingList(tokens[1]);
+        for (size_t i = 2; i + 1 < tokens.size(); i += 2) {
+            waitingList.addPassenger(tokens[i], tokens[i + 1]);
+        }
+        waitingLists[tokens[1]] = waitingList;
+    } else if (op == "WAITADD" && tokens.size() >= 4) {
+        if (waitingLists.find(tokens[1]) == waitingLists.end()) {
+            waitingLists[tokens[1]] = WaitingList(tokens[1]);
+        }
+        waitingLists[tokens[1]].addPassenger(tokens[2], tokens[3]);
+    } else if (op == "WAITDEL" && tokens.size() >= 3) {
+        auto it = waitingLists.find(tokens[1]);
+        if (it != waitingLists.end()) {
+            it->second.removePassenger(tokens[2]);
+        }
     }
+}
 
-    void cancelBooking() {
-        clearScreen();
-        printHeader("CANCEL BOOKING");
+void Journal::recordUserAdded(const User& user) {
+    append("ADDUSER," + quoteField(user.getUsername()) + "," + quoteField(user.getPassword()) + "," +
+           quoteField(user.getName()) + "," + (user.getIsAdmin() ? "admin" : "customer"));
+}
+
+class ColdArchive {
+private:
+    static constexpr int defaultRetentionDays = 30;
+
+    static SegmentStore& seatMapArchive() {
+        static SegmentStore& store = []() -> SegmentStore& {
+            SegmentStore& opened = SegmentStore::archivedSeatMaps();
+            opened.open();
+            return opened;
+        }();
+        return store;
+    }
+
+    static SegmentStore& reservationArchive() {
+        static SegmentStore& store = []() -> SegmentStore& {
+            SegmentStore& opened = SegmentStore::archivedReservations();
+            opened.open();
+            importLegacyReservations(opened);
+            return opened;
+        }();
+        return store;
+    }
+
+    static void appendRecord(string& records, const string& record) {
+        records += records.empty() ? "" : "\n";
+        records += record;
+    }
+
+    static void appendReservations(SegmentStore& store, const unordered_map<string, string>& byUser) {
+        for (const auto& entry : byUser) {
+            string records;
+            store.get(entry.first, records);
+            appendRecord(records, entry.second);
+            store.put(entry.first, records);
+        }
+    }
+
+    static void importLegacyReservations(SegmentStore& store) {
+        DatabaseManager* dbManager = DatabaseManager::getInstance();
+        if (!dbManager->fileExists("archive/reservations.txt")) {
+            return;
+        }
         
-        try {
-            vector<Reservation> customerReservations;
-            for (const auto& reservation : reservations) {
-                if (reservation.getUsername() == getUsername()) {
-                    customerReservations.push_back(reservation);
-                }
-            }
-            
-            if (customerReservations.empty()) {
-                printInfoMessage("You have no bookings to cancel.");
-                pressEnterToContinue();
-                return;
+        unordered_map<string, string> byUser;
+        dbManager->forEachRecord("archive/reservations.txt", [&](const CsvRecord& record) {
+            Reservation reservation;
+            if (Reservation::fromTokens(record.getFields(), reservation)) {
+                appendRecord(byUser[reservation.getUsername()], reservation.toRecord());
             }
-            
-            printSubHeader("Your Bookings");
-            
-            vector<pair<string, int>> columns = {
-                {"No.", 5},
-                {"Reservation ID", 20},
-                {"Flight ID", 15},
-                {"Airline", 25},
-                {"Destination", 26.5},
-                {"Seat Number", 15}
-            };
-            
-            printTableHeader(columns);
-            
-            for (size_t i = 0; i < customerReservations.size(); i++) {
-                vector<pair<string, int>> row = {
-                    {to_string(i + 1), 5},
-                    {customerReservations[i].getReservationID(), 21},
-                    {customerReservations[i].getFlightID(), 15},
-                    {customerReservations[i].getAirlineName(), 25},
-                    {customerReservations[i].getDestination(), 30},
-                    {customerReservations[i].getSeatNumber(), 15}
-                };
-                
-                printTableRow(row);
+        });
+        
+        appendReservations(store, byUser);
+        if (store.sync()) {
+            dbManager->deleteFile("archive/reservations.txt");
+        }
+    }
+
+public:
+    static int retentionDays() {
+        static const int configured = [] {
+            const char* value = getenv("AIRLINE_ARCHIVE_AFTER_DAYS");
+            int parsed = 0;
+            if (value != nullptr && parseInt(value, parsed)) {
+                return parsed;
             }
-            
-            printBackOption();
-            
-            int bookingIndex = getValidIntegerInput("\nEnter booking number to cancel:", 0, customerReservations.size());
+            return defaultRetentionDays;
+        }();
+        return configured;
+    }
 
-            if(bookingIndex == 0){
-                return;
+    static vector<string> archiveDeparted(int64_t cutoff) {
+        vector<string> archived;
+        vector<Flight*> departed = ScheduleIndex::departedBefore(cutoff);
+        if (departed.empty()) {
+            return archived;
+        }
+        
+        SegmentStore& seatMaps = seatMapArchive();
+        SegmentStore& reservationsByUser = reservationArchive();
+        
+        string flightRecords;
+        unordered_map<string, string> reservationRecords;
+        vector<pair<string, string>> packedSeatMaps;
+        vector<size_t> reservationCounts;
+        
+        for (const auto flight : departed) {
+            if (flight->getDepartureAt() == unknownScheduleTime) {
+                continue;
             }
             
-            Reservation& selectedReservation = customerReservations[bookingIndex - 1];
-            
-            clearScreen();
-            printSubHeader("Cancellation Confirmation");
-            
-            cout << "  Reservation ID: " << selectedReservation.getReservationID() << endl;
-            cout << "  Flight: " << selectedReservation.getFlightID() << " - " << selectedReservation.getAirlineName() << endl;
-            cout << "  Destination: " << selectedReservation.getDestination() << endl;
-            cout << "  Seat: " << selectedReservation.getSeatNumber() << endl;
-            
-            char confirm = getYesNoInput("\nConfirm cancellation? (y/n):");
-            
-            if (confirm == 'y') {
-                for (auto& flight : flights) {
-                    if (equalsIgnoreCase(flight.getFlightID(), selectedReservation.getFlightID())) {
-                        flight.cancelSeat(selectedReservation.getSeatNumber());
-                        break;
-                    }
-                }
+            const string& flightID = flight->getFlightID();
+            size_t reservationCount = 0;
+            if (!seatMaps.contains(flightID)) {
+                appendRecord(flightRecords, flight->toRecord());
                 
-                auto it = find_if(reservations.begin(), reservations.end(),
-                                 [&selectedReservation](const Reservation& r) { 
-                                     return equalsIgnoreCase(r.getReservationID(), selectedReservation.getReservationID()); 
-                                 });
-                
-                if (it != reservations.end()) {
-                    reservations.erase(it);
+                for (const auto& reservationID : ReservationStore::idsForFlight(flightID)) {
+                    const Reservation* reservation = ReservationStore::find(reservationID);
+                    if (reservation != nullptr) {
+                        appendRecord(reservationRecords[reservation->getUsername()], reservation->toRecord());
+                        reservationCount++;
+                    }
                 }
                 
-                Flight::saveAllFlights();
-                Reservation::saveAllReservations();
-                
-                printSuccessMessage("Booking has been successfully cancelled.");
-            } else {
-                printInfoMessage("Cancellation cancelled.");
+                flight->prepareSeatMap();
+                packedSeatMaps.emplace_back(flightID, flight->packedSeatMap());
             }
-        } catch (const exception& e) {
-            printErrorMessage(e.what());
+            archived.push_back(flightID);
+            reservationCounts.push_back(reservationCount);
+        }
+        
+        if (archived.empty()) {
+            return archived;
+        }
+        
+        appendReservations(reservationsByUser, reservationRecords);
+        DatabaseManager* dbManager = DatabaseManager::getInstance();
+        if (!reservationsByUser.sync() ||
+            (!flightRecords.empty() && !dbManager->saveData("archive/flights.txt", flightRecords))) {
+            archived.clear();
+            return archived;
+        }
+        
+        for (const auto& entry : packedSeatMaps) {
+            seatMaps.put(entry.first, entry.second);
+        }
+        if (!seatMaps.sync()) {
+            archived.clear();
+            return archived;
+        }
+        
+        string logRecords;
+        for (size_t i = 0; i < archived.size(); i++) {
+            const string& flightID = archived[i];
+            BookingService::unlinkFlight(flightID);
+            SegmentStore::seatMaps().erase(flightID);
+            SegmentStore::waitingLists().erase(flightID);
+            Journal::getInstance()->recordFlightArchived(flightID);
+            
+            appendRecord(logRecords, quoteField(getCurrentDateTime()) + "," + flightID + "," +
+                                     to_string(reservationCounts[i]));
+        }
+        dbManager->saveData("archive/log.txt", logRecords);
+        reservationsByUser.compactIfWorthwhile();
+        return archived;
+    }
+
+    static vector<string> archiveDeparted() {
+        int days = retentionDays();
+        if (days < 0) {
+            return vector<string>();
+        }
+        return archiveDeparted(ScheduleClock::now() - static_cast<int64_t>(days) * 86400);
+    }
+
+    static vector<Reservation> reservationsFor(const string& username) {
+        vector<Reservation> result;
+        string records;
+        if (!reservationArchive().get(username, records)) {
+            return result;
+        }
+        
+        unordered_set<string> seen;
+        CsvReader reader(records);
+        CsvRecord record;
+        while (reader.next(record)) {
+            vector<string_view> fields = record.getFields();
+            if (fields.size() < 8 || !seen.insert(string(fields[0])).second) {
+                continue;
+            }
+            
+            fields[6] = "Archived";
+            Reservation reservation;
+            if (Reservation::fromTokens(fields, reservation)) {
+                result.push_back(std::move(reservation));
+            }
+        }
+        return result;
+    }
+
+    static bool find(const string& flightID, vector<string>& fields) {
+        bool found = false;
+        DatabaseManager::getInstance()->forEachRecord("archive/flights.txt", [&](const CsvRecord& record) {
+            if (!record.empty() && equalsIgnoreCase(string(record[0]), flightID)) {
+                fields = record.toStrings();
+                found = true;
+            }
+        });
+        return found;
+    }
+};
+
+void Journal::sync() {
+    if (file.is_open()) {
+        file.flush();
+        DatabaseManager::syncFile(activeFilename);
+    }
+}
+
+int64_t Journal::seal() {
+    lock_guard<mutex> guard(writeMutex);
+    int64_t sealedGeneration = generation + 1;
+    
+    if (!file.is_open()) {
+        file.open(activeFilename, ios::app);
+    }
+    file << "SEAL," << sealedGeneration << '\n';
+    file.close();
+    if (file.fail() || !DatabaseManager::syncFile(activeFilename)) {
+        file.clear();
+        throw FileOperationException("Failed to seal journal.txt");
+    }
+    
+    DatabaseManager* dbManager = DatabaseManager::getInstance();
+    if (!dbManager->fileExists(sealedFilename)) {
+        if (rename(activeFilename, sealedFilename) != 0) {
+            throw FileOperationException("Failed to rename journal.txt");
+        }
+    } else {
+        ifstream active(activeFilename, ios::binary);
+        ofstream sealed(sealedFilename, ios::app | ios::binary);
+        sealed << active.rdbuf();
+        sealed.close();
+        if (sealed.fail() || !DatabaseManager::syncFile(sealedFilename)) {
+            throw FileOperationException("Failed to append journal.txt to " + string(sealedFilename));
+        }
+        active.close();
+        dbManager->deleteFile(activeFilename);
+    }
+    DatabaseManager::syncDirectoryOf(activeFilename);
+    
+    generation = sealedGeneration;
+    journalBytes = 0;
+    return sealedGeneration;
+}
+
+void Journal::replay() {
+    try {
+        DatabaseManager* dbManager = DatabaseManager::getInstance();
+        
+        size_t sealedRecords = 0;
+        size_t records = 0;
+        int64_t sealedGeneration = 0;
+        dbManager->forEachRecord(sealedFilename, [&](const CsvRecord& record) {
+            records++;
+            int64_t value = 0;
+            string_view text = record.size() >= 2 ? record[1] : string_view();
+            if (!record.empty() && record[0] == "SEAL" && from_chars(text.data(), text.data() + text.size(), value).ec == errc()) {
+                sealedRecords = records;
+                sealedGeneration = value;
+            }
+        });
+        
+        if (sealedGeneration > generation) {
+            records = 0;
+            dbManager->forEachRecord(sealedFilename, [&](const CsvRecord& record) {
+                if (++records <= sealedRecords) {
+                    applyRecord(record.toStrings());
+                }
+            });
+            
+            MappedFile sealed;
+            journalBytes += sealed.open(sealedFilename) ? sealed.size() : 0;
+            generation = sealedGeneration;
+        } else if (dbManager->fileExists(sealedFilename)) {
+            dbManager->deleteFile(sealedFilename);
         }
         
-        pressEnterToContinue();
+        dbManager->forEachRecord(activeFilename, [this](const CsvRecord& record) {
+            applyRecord(record.toStrings());
+        });
+        
+        MappedFile active;
+        journalBytes += active.open(activeFilename) ? active.size() : 0;
+    } catch (const exception& e) {
+        printErrorMessage("Error replaying journal: " + string(e.what()));
     }
-};
+}
 
-void User::loadUsers() {
+bool Journal::beginCompaction(string& snapshot, int64_t& sealedGeneration) {
+    METRIC_SPAN("journal_compact_capture");
     try {
-        for (auto user : users) {
-            delete user;
+        Flight::saveSeatMaps();
+        WaitingList::saveAllWaitingLists();
+        {
+            lock_guard<mutex> guard(writeMutex);
+            sealedGeneration = generation + 1;
+        }
+        snapshot = Snapshot::capture(sealedGeneration);
+        seal();
+        return true;
+    } catch (const exception& e) {
+        printErrorMessage("Error compacting journal: " + string(e.what()));
+        return false;
+    }
+}
+
+void Journal::finishCompaction(const string& snapshot, int64_t sealedGeneration) {
+    METRIC_SPAN("journal_compact");
+    try {
+        SegmentStore::seatMaps().compactIfWorthwhile();
+        SegmentStore::waitingLists().compactIfWorthwhile();
+        IdSequence::save();
+        if (!Snapshot::store(snapshot)) {
+            throw FileOperationException("Snapshot " + to_string(sealedGeneration) + " not saved; keeping " +
+                                         sealedFilename);
         }
-        users.clear();
-        
-        DatabaseManager* dbManager = DatabaseManager::getInstance();
-        string data = dbManager->loadData("users.txt");
         
-        stringstream dataStream(data);
-        string line;
+        DatabaseManager::getInstance()->deleteFile(sealedFilename);
+        DatabaseManager::syncDirectoryOf(sealedFilename);
         
-        while (getline(dataStream, line)) {
-            stringstream ss(line);
-            string token;
-            vector<string> tokens;
-            
-            while (getline(ss, token, ',')) {
-                tokens.push_back(token);
-            }
-            
-            if (tokens.size() >= 4) {
-                string username = tokens[0];
-                string password = tokens[1];
-                string name = tokens[2];
-                bool isAdmin = (tokens[3] == "admin");
-                
-                User* user;
-                if (isAdmin) {
-                    user = new Admin(username, password, name);
-                } else {
-                    user = new Customer(username, password, name);
-                }
-                
-                users.push_back(user);
-            }
-        }
+        lock_guard<mutex> guard(writeMutex);
+        snapshotBytes = snapshot.size();
     } catch (const exception& e) {
-        printErrorMessage("Error loading users: " + string(e.what()));
+        printErrorMessage("Error compacting journal: " + string(e.what()));
+    }
+}
+
+void Journal::compact() {
+    lock_guard<mutex> compactGuard(compactMutex);
+    string snapshot;
+    int64_t sealedGeneration = 0;
+    {
+        unique_lock<shared_mutex> catalogGuard(BookingService::catalog());
+        if (!beginCompaction(snapshot, sealedGeneration)) {
+            return;
+        }
+    }
+    finishCompaction(snapshot, sealedGeneration);
+}
+
+vector<string> BookingService::archiveDeparted() {
+    vector<string> archived;
+    {
+        unique_lock<shared_mutex> catalogGuard(catalogMutex);
+        archived = ColdArchive::archiveDeparted();
+    }
+    if (!archived.empty()) {
+        Journal::getInstance()->compact();
+    }
+    return archived;
+}
+
+vector<Reservation> BookingService::archivedReservationsFor(const string& username) {
+    shared_lock<shared_mutex> catalogGuard(catalogMutex);
+    return ColdArchive::reservationsFor(username);
+}
+
+void loadFromTextFiles() {
+    vector<Flight> loadedFlights;
+    vector<string> rejectedFlights;
+    vector<WaitingList> loadedWaitingLists;
+    vector<unique_ptr<User>> loadedUsers;
+    bool upgradedUsers = false;
+    vector<Reservation> loadedReservations;
+    
+    WorkerPool::start();
+    try {
+        WorkerPool::run({
+            [&] {
+                loadedFlights = Flight::readFlights(rejectedFlights);
+                loadedWaitingLists = WaitingList::readWaitingLists(loadedFlights);
+            },
+            [&] { loadedUsers = User::readUsers(upgradedUsers); },
+            [&] { loadedReservations = Reservation::readReservations(); }
+        });
+        
+        Flight::publishFlights(loadedFlights, rejectedFlights);
+        User::publishUsers(loadedUsers, upgradedUsers);
+        Reservation::publishReservations(loadedReservations);
+        WaitingList::publishWaitingLists(loadedWaitingLists);
+    } catch (...) {
+        WorkerPool::stop();
+        throw;
     }
+    WorkerPool::stop();
 }
 
 void initializeSystem() {
+    METRIC_SPAN("system_initialize");
     try {
-        createDirectory("seatmaps");
-        createDirectory("waitinglists");
+        SegmentStore::seatMaps().open();
+        SegmentStore::waitingLists().open();
+        
+        if (!Snapshot::load()) {
+            loadFromTextFiles();
+        }
         
-        Flight::loadFlights();
-        User::loadUsers();
-        Reservation::loadReservations();
-        WaitingList::loadWaitingLists();
+        DestinationIndex::build();
+        Journal::getInstance()->replay();
+        IdSequence::seed();
     } catch (const exception& e) {
         printErrorMessage("Error initializing system: " + string(e.what()));
         exit(1);
@@ -2896,16 +7719,18 @@ void signUp() {
             }
         }
 
-        User* newUser;
-        if (userType == 1) {
-            newUser = new Admin(username, password, name);
-        } else {
-            newUser = new Customer(username, password, name);
+        string hashedPassword = PasswordHasher::hash(password);
+        {
+            unique_lock<shared_mutex> catalogGuard(BookingService::catalog());
+            User* newUser;
+            if (userType == 1) {
+                newUser = UserDirectory::add(make_unique<Admin>(username, hashedPassword, name));
+            } else {
+                newUser = UserDirectory::add(make_unique<Customer>(username, hashedPassword, name));
+            }
+            Journal::getInstance()->recordUserAdded(*newUser);
         }
 
-        users.push_back(newUser);
-        newUser->saveToFile();
-
         printSuccessMessage("Sign up successful! You can now log in.");
     } catch (const exception& e) {
         printErrorMessage(e.what());
@@ -2979,22 +7804,590 @@ void logIn() {
     }
 }
 
-int main() {
+class BatchProcessor {
+private:
+    static string response(const string& outcome, const vector<string>& fields) {
+        string line = outcome;
+        for (const auto& field : fields) {
+            line += "," + quoteField(field);
+        }
+        return line;
+    }
+
+    static void requireFields(const vector<string>& tokens, size_t count, const string& usage) {
+        if (tokens.size() < count) {
+            throw ValidationException("Usage: " + usage);
+        }
+    }
+
+    static const User* requireUser(const string& username) {
+        const User* user = UserDirectory::find(username);
+        if (user != nullptr) {
+            return user;
+        }
+        throw ValidationException("Unknown user: " + username);
+    }
+
+    static string createFlight(const vector<string>& tokens) {
+        requireFields(tokens, 7, "CREATE_FLIGHT,airline,planeID,capacity,destination,departure,arrival");
+        
+        if (!isNumeric(tokens[3]) || tokens[3].empty() || stoi(tokens[3]) <= 0) {
+            throw ValidationException("Capacity must be a number greater than zero");
+        }
+        for (size_t i = 1; i < 7; i++) {
+            if (tokens[i].empty() || isOnlySpaces(tokens[i])) {
+                throw ValidationException("Flight fields cannot be empty");
+            }
+        }
+        
+        int64_t departureAt;
+        int64_t arrivalAt;
+        if (!parseScheduleTime(tokens[5], departureAt) || !parseScheduleTime(tokens[6], arrivalAt)) {
+            throw ValidationException("Times must look like May 10, 2025 - 08:00 AM");
+        }
+        if (arrivalAt <= departureAt) {
+            throw ValidationException("Arrival time must be after the departure time");
+        }
+        
+        unique_lock<shared_mutex> catalogGuard(BookingService::catalog());
+        
+        Flight flight(tokens[1], tokens[2], stoi(tokens[3]), tokens[4], departureAt, arrivalAt);
+        Journal::getInstance()->recordFlightAdded(flight);
+        FlightRegistry::add(flight);
+        DestinationIndex::add(flight);
+        waitingLists[flight.getFlightID()] = WaitingList(flight.getFlightID());
+        
+        return response("OK", {tokens[0], flight.getFlightID()});
+    }
+
+    static string book(const vector<string>& tokens) {
+        requireFields(tokens, 5, "BOOK,flightID,username,seat|*,payment");
+        
+        const User* user = requireUser(tokens[2]);
+        Reservation reservation;
+        SeatResult result;
+        
+        if (tokens[3] == "*") {
+            result = BookingService::bookFirstAvailable(tokens[1], user->getUsername(), user->getName(),
+                                                        tokens[4], reservation);
+        } else {
+            result = BookingService::book(tokens[1], tokens[3], user->getUsername(), user->getName(),
+                                          tokens[4], reservation);
+        }
+        
+        if (result != SeatResult::Ok) {
+            throw BookingException(seatResultMessage(result, tokens[3]));
+        }
+        return response("OK", {tokens[0], reservation.getReservationID(), reservation.getSeatNumber()});
+    }
+
+    static string cancel(const vector<string>& tokens) {
+        requireFields(tokens, 3, "CANCEL,username,reservationID");
+        
+        if (!BookingService::cancel(tokens[1], tokens[2])) {
+            throw BookingException("No booking " + tokens[2] + " for user " + tokens[1]);
+        }
+        return response("OK", {tokens[0], tokens[2]});
+    }
+
+    static string setStatus(const vector<string>& tokens) {
+        requireFields(tokens, 3, "STATUS,flightID,status");
+        
+        if (tokens[2].empty() || isOnlySpaces(tokens[2])) {
+            throw ValidationException("Flight status cannot be empty");
+        }
+        
+        unique_lock<shared_mutex> catalogGuard(BookingService::catalog());
+        
+        Flight* flight = FlightRegistry::find(tokens[1]);
+        if (flight == nullptr) {
+            throw ValidationException("Flight not found: " + tokens[1]);
+        }
+        
+        flight->setStatus(tokens[2]);
+        Journal::getInstance()->recordFlightUpdated(*flight);
+        return response("OK", {tokens[0], flight->getFlightID(), flight->getStatus()});
+    }
+
+    static string joinWaitingList(const vector<string>& tokens) {
+        requireFields(tokens, 3, "WAITLIST,flightID,username");
+        
+        const User* user = requireUser(tokens[2]);
+        WaitlistResult result = BookingService::joinWaitingList(tokens[1], user->getUsername(), user->getName());
+        if (result != WaitlistResult::Queued) {
+            throw ValidationException(waitlistResultMessage(result, tokens[1]));
+        }
+        return response("OK", {tokens[0], tokens[1], user->getUsername()});
+    }
+
+    static string search(const vector<string>& tokens) {
+        requireFields(tokens, 2, "SEARCH,destination");
+        
+        shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+        vector<Flight*> matchingFlights = DestinationIndex::search(tokens[1]);
+        
+        return response("OK", flightListing(tokens[0], matchingFlights));
+    }
+
+    static vector<string> flightListing(const string& op, const vector<Flight*>& matchingFlights) {
+        vector<string> fields = {op, to_string(matchingFlights.size())};
+        for (const auto flight : matchingFlights) {
+            fields.push_back(flight->getFlightID());
+            fields.push_back(flight->getAirlineName());
+            fields.push_back(flight->getDestination());
+            fields.push_back(flight->getDepartureTime());
+            fields.push_back(flight->getArrivalTime());
+            fields.push_back(to_string(flight->getAvailableSeats()));
+        }
+        return fields;
+    }
+
+    static string listFlights(const vector<string>& tokens) {
+        FlightCatalog::Query query;
+        if (tokens.size() > 1) {
+            query.destination = tokens[1];
+        }
+        if (tokens.size() > 2 && !tokens[2].empty() && !parseScheduleTime(tokens[2], query.departingAfter)) {
+            throw ValidationException("Invalid departure time: " + tokens[2]);
+        }
+        if (tokens.size() > 3) {
+            query.openOnly = toLower(tokens[3]) == "open";
+        }
+        
+        shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+        return response("OK", flightListing(tokens[0], FlightCatalog::select(query)));
+    }
+
+    static string schedule(const vector<string>& tokens) {
+        requireFields(tokens, 2, "SCHEDULE,from[,to]");
+        
+        int64_t from;
+        int64_t to = INT64_MAX;
+        if (!parseScheduleTime(tokens[1], from) ||
+            (tokens.size() > 2 && !tokens[2].empty() && !parseScheduleTime(tokens[2], to))) {
+            throw ValidationException("Times must look like May 10, 2025 - 08:00 AM");
+        }
+        
+        shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+        return response("OK", flightListing(tokens[0], ScheduleIndex::departingBetween(from, to)));
+    }
+
+    static string seatMap(const vector<string>& tokens) {
+        requireFields(tokens, 2, "SEATMAP,flightID");
+        
+        vector<string> rows;
+        int availableSeats = 0;
+        if (!BookingService::seatMapFor(tokens[1], rows, availableSeats)) {
+            throw ValidationException("Flight not found: " + tokens[1]);
+        }
+        
+        vector<string> fields = {tokens[0], tokens[1], to_string(availableSeats)};
+        fields.insert(fields.end(), rows.begin(), rows.end());
+        return response("OK", fields);
+    }
+
+    static string archive(const vector<string>& tokens) {
+        if (tokens.size() > 1 && !tokens[1].empty()) {
+            vector<string> fields;
+            if (!ColdArchive::find(tokens[1], fields)) {
+                throw ValidationException("Archived flight not found: " + tokens[1]);
+            }
+            fields.insert(fields.begin(), tokens[0]);
+            return response("OK", fields);
+        }
+        
+        vector<string> archived = BookingService::archiveDeparted();
+        vector<string> fields = {tokens[0], to_string(archived.size())};
+        fields.insert(fields.end(), archived.begin(), archived.end());
+        return response("OK", fields);
+    }
+
+    static string metrics(const vector<string>& tokens) {
+        if (tokens.size() > 1 && !tokens[1].empty()) {
+            string action = toLower(tokens[1]);
+            if (action == "on" || action == "off") {
+                Metrics::setEnabled(action == "on");
+            } else if (action == "reset") {
+                Metrics::reset();
+            } else {
+                throw ValidationException("Usage: METRICS[,on|off|reset]");
+            }
+        }
+        
+        vector<string> fields = {tokens[0]};
+        vector<string> summary = Metrics::summaryFields();
+        fields.insert(fields.end(), summary.begin(), summary.end());
+        return response("OK", fields);
+    }
+
+    static string trace(const vector<string>& tokens) {
+        int limit = 50;
+        if (tokens.size() > 1 && !tokens[1].empty()) {
+            string action = toLower(tokens[1]);
+            if (action == "on" || action == "off") {
+                Metrics::setTracing(action == "on");
+            } else if (!parseInt(tokens[1], limit) || limit <= 0) {
+                throw ValidationException("Usage: TRACE[,on|off|count]");
+            }
+        }
+        
+        vector<Metrics::TraceEvent> events = Metrics::recentTraces(limit);
+        vector<string> fields = {tokens[0], Metrics::tracing() ? "on" : "off", to_string(events.size())};
+        for (const auto& event : events) {
+            fields.push_back(event.name);
+            fields.push_back(to_string(event.thread));
+            fields.push_back(to_string(event.startMicroseconds));
+            fields.push_back(to_string(event.durationNanoseconds));
+            fields.push_back(to_string(event.depth));
+        }
+        return response("OK", fields);
+    }
+
+public:
+    static string execute(const string& line) {
+        vector<string> tokens = splitCsvLine(line);
+        string op = tokens.empty() ? "" : toLower(tokens[0]);
+        
+        try {
+            if (op == "create_flight") {
+                return createFlight(tokens);
+            } else if (op == "book") {
+                return book(tokens);
+            } else if (op == "cancel") {
+                return cancel(tokens);
+            } else if (op == "status") {
+                return setStatus(tokens);
+            } else if (op == "waitlist") {
+                return joinWaitingList(tokens);
+            } else if (op == "search") {
+                return search(tokens);
+            } else if (op == "flights") {
+                return listFlights(tokens);
+            } else if (op == "schedule") {
+                return schedule(tokens);
+            } else if (op == "seatmap") {
+                return seatMap(tokens);
+            } else if (op == "archive") {
+                return archive(tokens);
+            } else if (op == "metrics") {
+                return metrics(tokens);
+            } else if (op == "trace") {
+                return trace(tokens);
+            }
+            throw ValidationException("Unknown operation: " + (tokens.empty() ? line : tokens[0]));
+        } catch (const exception& e) {
+            METRIC_COUNT("batch_errors");
+            return response("ERR", {tokens.empty() ? "" : tokens[0], e.what()});
+        }
+    }
+
+    static int run(const string& filename) {
+        ifstream file;
+        if (!filename.empty()) {
+            file.open(filename);
+            if (!file.is_open()) {
+                cout << response("ERR", {"OPEN", "Failed to open file: " + filename}) << "\n";
+                return 1;
+            }
+        }
+        istream& input = filename.empty() ? cin : file;
+        
+        Journal* journal = Journal::getInstance();
+        journal->setBuffered(true);
+        
+        int failures = 0;
+        string line;
+        while (getline(input, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            
+            string result = execute(line);
+            if (result.compare(0, 3, "ERR") == 0) {
+                failures++;
+            }
+            cout << result << "\n";
+        }
+        
+        PromotionWorker::drain();
+        journal->setBuffered(false);
+        journal->compact();
+        Metrics::dump();
+        
+        cout.flush();
+        return failures == 0 ? 0 : 1;
+    }
+};
+
+#ifndef _WIN32
+class ReservationServer {
+private:
+    struct Connection {
+        int fd;
+        string input;
+        string output;
+        bool closing;
+    };
+
+    static constexpr const char* defaultAddress = "127.0.0.1";
+    static constexpr size_t maxPendingInput = 64 * 1024;
+
+    static volatile sig_atomic_t stopRequested;
+
+    static void requestStop(int) {
+        stopRequested = 1;
+    }
+
+    static int openListener(int port, const string& host) {
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+            throw ValidationException("Invalid listen address: " + host);
+        }
+        
+        int listener = socket(AF_INET, SOCK_STREAM, 0);
+        if (listener < 0) {
+            throw FileOperationException("Failed to create socket");
+        }
+        
+        int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        
+        if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listener, 64) < 0) {
+            close(listener);
+            throw FileOperationException("Failed to listen on " + host + ":" + to_string(port));
+        }
+        
+        fcntl(listener, F_SETFL, fcntl(listener, F_GETFL, 0) | O_NONBLOCK);
+        return listener;
+    }
+
+    static void acceptConnections(int listener, vector<Connection>& connections) {
+        while (true) {
+            int fd = accept(listener, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+            connections.push_back({fd, "", "", false});
+        }
+    }
+
+    static void readRequests(Connection& connection) {
+        char buffer[4096];
+        while (true) {
+            if (connection.input.size() >= maxPendingInput) {
+                break;
+            }
+            
+            ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                connection.input.append(buffer, received);
+            } else {
+                if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                    connection.closing = true;
+                }
+                break;
+            }
+        }
+        
+        size_t start = 0;
+        size_t end;
+        while (!connection.closing && (end = connection.input.find('\n', start)) != string::npos) {
+            string line = connection.input.substr(start, end - start);
+            start = end + 1;
+            
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty()) {
+                continue;
+            }
+            if (toLower(line) == "quit") {
+                connection.closing = true;
+                break;
+            }
+            if (line.compare(0, 4, "GET ") == 0) {
+                connection.output += httpResponse(line);
+                connection.closing = true;
+                break;
+            }
+            
+            connection.output += BatchProcessor::execute(line) + "\n";
+        }
+        connection.input.erase(0, start);
+        
+        if (!connection.closing && connection.input.size() >= maxPendingInput) {
+            connection.output += "ERR,REQUEST," + quoteField("Request line exceeds " + to_string(maxPendingInput) + " bytes") + "\n";
+            connection.input.clear();
+            connection.closing = true;
+        }
+    }
+
+    static string httpResponse(const string& requestLine) {
+        size_t pathEnd = requestLine.find(' ', 4);
+        string path = requestLine.substr(4, pathEnd == string::npos ? string::npos : pathEnd - 4);
+        
+        string status = "200 OK";
+        string body;
+        if (path == "/metrics") {
+            body = Metrics::renderPrometheus();
+        } else {
+            status = "404 Not Found";
+            body = "Not found\n";
+        }
+        
+        return "HTTP/1.0 " + status + "\r\n"
+               "Content-Type: text/plain; version=0.0.4\r\n"
+               "Content-Length: " + to_string(body.size()) + "\r\n"
+               "Connection: close\r\n\r\n" + body;
+    }
+
+    static void writeResponses(Connection& connection) {
+        while (!connection.output.empty()) {
+            ssize_t sent = send(connection.fd, connection.output.data(), connection.output.size(), 0);
+            if (sent <= 0) {
+                if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    connection.output.clear();
+                    connection.closing = true;
+                }
+                return;
+            }
+            connection.output.erase(0, sent);
+        }
+    }
+
+public:
+    static int run(const string& portText, const string& host) {
+        int port = 0;
+        int listener;
+        try {
+            if (!parseInt(portText, port) || port < 1 || port > 65535) {
+                throw ValidationException("Invalid port: " + portText + " (usage: --serve <port> [address])");
+            }
+            listener = openListener(port, host.empty() ? defaultAddress : host);
+        } catch (const exception& e) {
+            cout << "ERR,SERVE," << quoteField(e.what()) << "\n";
+            return 1;
+        }
+        
+        signal(SIGPIPE, SIG_IGN);
+        signal(SIGINT, requestStop);
+        signal(SIGTERM, requestStop);
+        
+        cout << "OK,SERVE," << port << "," << (host.empty() ? defaultAddress : host) << "\n";
+        
+        Journal* journal = Journal::getInstance();
+        journal->setBuffered(true);
+        
+        vector<Connection> connections;
+        vector<pollfd> descriptors;
+        
+        while (!stopRequested) {
+            descriptors.clear();
+            descriptors.push_back({listener, POLLIN, 0});
+            for (const auto& connection : connections) {
+                short events = POLLIN;
+                if (!connection.output.empty()) {
+                    events |= POLLOUT;
+                }
+                descriptors.push_back({connection.fd, events, 0});
+            }
+            
+            if (poll(descriptors.data(), descriptors.size(), 1000) < 0) {
+                continue;
+            }
+            
+            if (descriptors[0].revents & POLLIN) {
+                acceptConnections(listener, connections);
+            }
+            
+            for (size_t i = 1; i < descriptors.size(); i++) {
+                if (descriptors[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    readRequests(connections[i - 1]);
+                }
+            }
+            
+            journal->setBuffered(false);
+            BookingService::compactIfDue();
+            journal->setBuffered(true);
+            Metrics::dumpIfDue();
+            
+            for (auto& connection : connections) {
+                writeResponses(connection);
+            }
+            
+            for (size_t i = connections.size(); i-- > 0;) {
+                if (connections[i].closing && connections[i].output.empty()) {
+                    close(connections[i].fd);
+                    connections.erase(connections.begin() + i);
+                }
+            }
+        }
+        
+        for (const auto& connection : connections) {
+            close(connection.fd);
+        }
+        close(listener);
+        
+        PromotionWorker::stop();
+        journal->setBuffered(false);
+        journal->compact();
+        Metrics::dump();
+        return 0;
+    }
+};
+
+volatile sig_atomic_t ReservationServer::stopRequested = 0;
+#endif
+
+#ifndef AIRLINE_NO_MAIN
+int main(int argc, char* argv[]) {
+    Metrics::configure();
     initializeSystem();
+    CompactionWorker::start();
+
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        PromotionWorker::start();
+        int status = BatchProcessor::run(argc > 2 ? argv[2] : "");
+        PromotionWorker::stop();
+        CompactionWorker::stop();
+        return status;
+    }
+
+    if (argc > 1 && string(argv[1]) == "--serve") {
+        #ifdef _WIN32
+            printErrorMessage("Server mode is not supported on Windows.");
+            int status = 1;
+        #else
+            PromotionWorker::start();
+            int status = ReservationServer::run(argc > 2 ? argv[2] : "", argc > 3 ? argv[3] : "");
+        #endif
+        PromotionWorker::stop();
+        CompactionWorker::stop();
+        return status;
+    }
 
     #ifdef _WIN32
         system("chcp 65001 > nul");
         system("title Airline Reservation System");
     #endif
 
+    Renderer::install();
+
     int choice;
     do {
         clearScreen();
         
         printHeader("AIRLINE RESERVATION SYSTEM");
         
-        cout << "  Welcome to the Airline Reservation System!" << endl;
-        cout << "  " << getCurrentDateTime() << endl;
+        cout << "  Welcome to the Airline Reservation System!\n";
+        cout << "  " << getCurrentDateTime() << "\n";
         
         printSeparator();
         
@@ -3017,11 +8410,11 @@ int main() {
         }
     } while (choice != 3);
 
-    for (auto user : users) {
-        delete user;
-    }
-
-    delete DatabaseManager::getInstance();
+    CompactionWorker::stop();
+    Journal::getInstance()->compact();
+    Metrics::dump();
+    Renderer::uninstall();
 
     return 0;
 }
+#endif
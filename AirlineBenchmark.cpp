@@ -0,0 +1,373 @@
+#define AIRLINE_NO_MAIN
+#include "Airline.cpp"
+
+#include <chrono>
+#include <filesystem>
+
+#ifdef _WIN32
+#define CHDIR(dir) _chdir(dir)
+#else
+#define CHDIR(dir) chdir(dir)
+#endif
+
+class LatencyRecorder {
+private:
+    string name;
+    vector<double> samples;
+    double totalNanoseconds;
+
+public:
+    explicit LatencyRecorder(const string& name) : name(name), totalNanoseconds(0) {}
+
+    template <typename Operation>
+    void measure(Operation operation) {
+        auto start = chrono::steady_clock::now();
+        operation();
+        double elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+        samples.push_back(elapsed);
+        totalNanoseconds += elapsed;
+    }
+
+    void report() {
+        if (samples.empty()) {
+            printf("%-30s %10s\n", name.c_str(), "skipped");
+            return;
+        }
+
+        sort(samples.begin(), samples.end());
+        size_t count = samples.size();
+        double p50 = samples[count / 2];
+        double p99 = samples[min(count - 1, static_cast<size_t>(count * 0.99))];
+
+        printf("%-30s %10zu %12.2f %14.0f %12.2f %12.2f\n", name.c_str(), count, totalNanoseconds / 1e6,
+               count / (totalNanoseconds / 1e9), p50 / 1e3, p99 / 1e3);
+    }
+};
+
+class AirlineBenchmark {
+private:
+    static constexpr const char* marker = ".airline-bench";
+    static constexpr int waitlistCapacity = 60;
+
+    size_t flightCount;
+    size_t userCount;
+    size_t reservationCount;
+    size_t operationCount;
+    int repeatCount;
+    int capacity;
+    string directory;
+    mt19937_64 random;
+
+    static vector<string> destinationPool() {
+        static const char* const origins[] = {"Manila", "Cebu", "Davao", "Clark", "Iloilo"};
+        static const char* const cities[] = {"Tokyo", "Seoul", "Singapore", "Bangkok", "Hong Kong", "Taipei",
+                                             "Dubai", "Sydney", "Los Angeles", "Vancouver", "Bacolod", "Tacloban",
+                                             "Puerto Princesa", "Zamboanga", "Cagayan de Oro", "General Santos",
+                                             "Kalibo", "Laoag", "Legazpi", "Tagbilaran"};
+
+        vector<string> pool;
+        for (const auto origin : origins) {
+            for (const auto city : cities) {
+                pool.push_back(string(origin) + " to " + city);
+            }
+        }
+        return pool;
+    }
+
+    static string userName(size_t index) {
+        return "bench" + to_string(index);
+    }
+
+    bool prepareDirectory() {
+        namespace fs = std::filesystem;
+
+        error_code error;
+        fs::path root(directory);
+        if (fs::exists(root)) {
+            if (!fs::exists(root / marker) && !fs::is_empty(root)) {
+                cerr << "Refusing to reuse non-benchmark directory: " << directory << "\n";
+                return false;
+            }
+            fs::remove_all(root, error);
+        }
+
+        if (!fs::create_directories(root, error) && error) {
+            cerr << "Failed to create " << directory << ": " << error.message() << "\n";
+            return false;
+        }
+
+        ofstream(root / marker).put('\n');
+        return CHDIR(directory.c_str()) == 0;
+    }
+
+    void generate() {
+        auto start = chrono::steady_clock::now();
+
+        initializeSystem();
+        Journal* journal = Journal::getInstance();
+        journal->setBuffered(true);
+
+        string password = PasswordHasher::hash("benchmark");
+        for (size_t i = 0; i < userCount; i++) {
+            UserDirectory::add(make_unique<Customer>(userName(i), password, "Bench Customer " + to_string(i)));
+        }
+
+        static const char* const airlines[] = {"PAL", "Cebu Pacific", "AirAsia", "Cathay", "Singapore Air",
+                                               "ANA", "Emirates", "Qantas"};
+        vector<string> destinations = destinationPool();
+
+        int64_t firstDeparture = (ScheduleClock::now() / 3600 + 24) * 3600;
+
+        {
+            unique_lock<shared_mutex> catalogGuard(BookingService::catalog());
+            for (size_t i = 0; i < flightCount; i++) {
+                int64_t departure = firstDeparture + static_cast<int64_t>(i % 8760) * 3600;
+                Flight flight(airlines[i % 8], "PL" + to_string(i), capacity,
+                              destinations[(i * 7) % destinations.size()], departure, departure + 7200);
+                FlightRegistry::add(flight);
+                DestinationIndex::add(flight);
+                waitingLists[flight.getFlightID()] = WaitingList(flight.getFlightID());
+            }
+        }
+
+        for (size_t i = 0; i < reservationCount; i++) {
+            const Flight& flight = flights[i % flightCount];
+            string username = userName(i % userCount);
+            Reservation booked;
+            BookingService::bookFirstAvailable(flight.getFlightID(), username, "Bench Passenger", "GCash", booked);
+        }
+
+        journal->setBuffered(false);
+        Flight::saveAllFlights();
+        Reservation::saveAllReservations();
+        User::saveAllUsers();
+        journal->compact();
+
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        printf("Generated %zu flights (%d seats each), %zu users, %zu reservations in %.2f s\n\n",
+               flights.size(), capacity, UserDirectory::size(), reservations.size(), seconds);
+    }
+
+    void benchmarkLoading() {
+        LatencyRecorder initializeFromSnapshot("initializeSystem (snapshot)");
+        LatencyRecorder initializeFromText("initializeSystem (text files)");
+        LatencyRecorder loadFlights("Flight::loadFlights");
+        LatencyRecorder loadReservations("Reservation::loadReservations");
+
+        for (int i = 0; i < repeatCount; i++) {
+            initializeFromSnapshot.measure([] { initializeSystem(); });
+        }
+
+        rename("snapshot.bin", "snapshot.bin.bench");
+        for (int i = 0; i < repeatCount; i++) {
+            initializeFromText.measure([] { initializeSystem(); });
+            loadFlights.measure([] { Flight::loadFlights(); });
+            DestinationIndex::build();
+            loadReservations.measure([] { Reservation::loadReservations(); });
+        }
+        rename("snapshot.bin.bench", "snapshot.bin");
+        initializeSystem();
+
+        initializeFromSnapshot.report();
+        initializeFromText.report();
+        loadFlights.report();
+        loadReservations.report();
+    }
+
+    void benchmarkSearch() {
+        LatencyRecorder search("destination search");
+
+        vector<string> destinations = destinationPool();
+        static const char* const fragments[] = {"tokyo", "Manila to", "cebu", "santos", "to Sydney", "ila"};
+
+        size_t matches = 0;
+        for (size_t i = 0; i < operationCount; i++) {
+            string needle = i % 2 == 0 ? destinations[random() % destinations.size()] : fragments[random() % 6];
+            search.measure([&] {
+                shared_lock<shared_mutex> catalogGuard(BookingService::catalog());
+                matches += DestinationIndex::search(needle).size();
+            });
+        }
+
+        search.report();
+    }
+
+    void benchmarkBooking() {
+        LatencyRecorder firstAvailable("Flight::getFirstAvailableSeat");
+        LatencyRecorder book("BookingService::book");
+        LatencyRecorder cancel("BookingService::cancel");
+
+        vector<pair<string, string>> booked;
+        booked.reserve(operationCount);
+
+        for (size_t i = 0; i < operationCount; i++) {
+            Flight& flight = flights[random() % flights.size()];
+            string seat;
+            firstAvailable.measure([&] { seat = flight.getFirstAvailableSeat(); });
+            if (seat.empty()) {
+                continue;
+            }
+
+            string username = userName(random() % userCount);
+            Reservation reservation;
+            SeatResult result = SeatResult::Ok;
+            book.measure([&] {
+                result = BookingService::book(flight.getFlightID(), seat, username, "Bench Passenger", "GCash",
+                                              reservation);
+            });
+
+            if (result == SeatResult::Ok) {
+                booked.emplace_back(username, reservation.getReservationID());
+            }
+        }
+
+        shuffle(booked.begin(), booked.end(), random);
+        for (const auto& entry : booked) {
+            cancel.measure([&] { BookingService::cancel(entry.first, entry.second); });
+        }
+
+        firstAvailable.report();
+        book.report();
+        cancel.report();
+    }
+
+    void benchmarkPromotion() {
+        LatencyRecorder join("BookingService::joinWaitingList");
+        LatencyRecorder promote("cancel + waitlist promotion");
+
+        size_t rounds = max<size_t>(1, operationCount / waitlistCapacity);
+        for (size_t round = 0; round < rounds; round++) {
+            string flightID;
+            {
+                unique_lock<shared_mutex> catalogGuard(BookingService::catalog());
+                Flight flight("PAL", "WL" + to_string(round), waitlistCapacity, "Manila to Waitlist",
+                              flights.front().getDepartureAt(), flights.front().getArrivalAt());
+                flightID = flight.getFlightID();
+                FlightRegistry::add(flight);
+                DestinationIndex::add(flight);
+                waitingLists[flightID] = WaitingList(flightID);
+            }
+
+            vector<pair<string, string>> seated;
+            for (int i = 0; i < waitlistCapacity; i++) {
+                string username = userName(i % userCount);
+                Reservation reservation;
+                if (BookingService::bookFirstAvailable(flightID, username, "Bench Passenger", "GCash",
+                                                       reservation) == SeatResult::Ok) {
+                    seated.emplace_back(username, reservation.getReservationID());
+                }
+            }
+
+            for (int i = 0; i < waitlistCapacity; i++) {
+                string username = userName((waitlistCapacity + i) % userCount);
+                join.measure([&] { BookingService::joinWaitingList(flightID, username, "Bench Waiter"); });
+            }
+
+            for (const auto& entry : seated) {
+                promote.measure([&] { BookingService::cancel(entry.first, entry.second); });
+            }
+
+            BookingService::deleteFlight(flightID);
+        }
+
+        join.report();
+        promote.report();
+    }
+
+    void benchmarkPersistence() {
+        LatencyRecorder saveFlights("Flight::saveAllFlights");
+        LatencyRecorder saveReservations("Reservation::saveAllReservations");
+        LatencyRecorder compact("Journal::compact");
+
+        for (int i = 0; i < repeatCount; i++) {
+            saveFlights.measure([] { Flight::saveAllFlights(); });
+            saveReservations.measure([] { Reservation::saveAllReservations(); });
+            compact.measure([] { Journal::getInstance()->compact(); });
+        }
+
+        saveFlights.report();
+        saveReservations.report();
+        compact.report();
+    }
+
+public:
+    AirlineBenchmark()
+        : flightCount(1000), userCount(1000), reservationCount(10000), operationCount(10000),
+          repeatCount(3), capacity(180), directory("bench-data"), random(20251) {}
+
+    bool parseArguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; i++) {
+            string option = argv[i];
+            if (i + 1 >= argc) {
+                cerr << "Missing value for " << option << "\n";
+                return false;
+            }
+
+            string value = argv[++i];
+            if (option == "--dir") {
+                directory = value;
+                continue;
+            }
+
+            int parsed = 0;
+            if (!parseInt(value, parsed) || parsed <= 0) {
+                cerr << "Invalid value for " << option << ": " << value << "\n";
+                return false;
+            }
+
+            if (option == "--flights") {
+                flightCount = parsed;
+            } else if (option == "--users") {
+                userCount = parsed;
+            } else if (option == "--reservations") {
+                reservationCount = parsed;
+            } else if (option == "--ops") {
+                operationCount = parsed;
+            } else if (option == "--repeat") {
+                repeatCount = parsed;
+            } else if (option == "--capacity") {
+                capacity = parsed;
+            } else {
+                cerr << "Unknown option: " << option << "\n";
+                return false;
+            }
+        }
+
+        size_t seatsNeeded = reservationCount + reservationCount / 4 + operationCount;
+        if (flightCount * capacity < seatsNeeded) {
+            flightCount = (seatsNeeded + capacity - 1) / capacity;
+        }
+        return true;
+    }
+
+    int run() {
+        if (!prepareDirectory()) {
+            return 1;
+        }
+
+        generate();
+        CompactionWorker::start();
+
+        printf("%-30s %10s %12s %14s %12s %12s\n", "operation", "ops", "total ms", "ops/s", "p50 us", "p99 us");
+        printf("%s\n", string(94, '-').c_str());
+
+        benchmarkLoading();
+        benchmarkSearch();
+        benchmarkBooking();
+        benchmarkPromotion();
+        benchmarkPersistence();
+        CompactionWorker::stop();
+        return 0;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    AirlineBenchmark benchmark;
+    if (!benchmark.parseArguments(argc, argv)) {
+        cerr << "Usage: AirlineBenchmark [--flights N] [--users N] [--reservations N] [--ops N] "
+                "[--repeat N] [--capacity N] [--dir path]\n";
+        return 1;
+    }
+    return benchmark.run();
+}